@@ -1,260 +0,0 @@
-#define NOMINMAX // To avoid min/max macro conflict on Windows
-
-#include <vector>
-#include <memory>
-#include <iostream>
-#include <algorithm>
-#include "Core.h"
-
-
-enum class AquariumCreatureType {
-    NPCreature,
-    BiggerFish,
-    PinkFish,
-    SharkFish
-};
-
-string AquariumCreatureTypeToString(AquariumCreatureType t);
-
-class AquariumLevelPopulationNode{
-    public:
-        AquariumLevelPopulationNode() = default;
-        AquariumLevelPopulationNode(AquariumCreatureType creature_type, int population) {
-            this->creatureType = creature_type;
-            this->population = population;
-            this->currentPopulation = 0;
-        };
-        AquariumCreatureType creatureType;
-        int population;
-        int currentPopulation;
-};
-
-class AquariumLevel : public GameLevel {
-    public:
-        AquariumLevel(int levelNumber, int targetScore)
-        : GameLevel(levelNumber), m_level_score(0), m_targetScore(targetScore){};
-        void ConsumePopulation(AquariumCreatureType creature, int power);
-        bool isCompleted() override;
-        void populationReset();
-        void levelReset(){m_level_score=0;this->populationReset();}
-        virtual std::vector<AquariumCreatureType> Repopulate();
-    protected:
-        std::vector<std::shared_ptr<AquariumLevelPopulationNode>> m_levelPopulation;
-        int m_level_score;
-        int m_targetScore;
-
-};
-
-
-class PlayerCreature : public Creature {
-public:
-
-    PlayerCreature(float x, float y, int speed, std::shared_ptr<GameSprite> sprite);
-    void move();
-    void draw() const;
-    void update();
-    void changeSpeed(int speed);
-    void setLives(int lives) { m_lives = lives; }
-    void setDirection(float dx, float dy);
-    float isXDirectionActive() { return m_dx != 0; }
-    float isYDirectionActive() {return m_dy != 0; }
-    float getDx() { return m_dx; }
-    float getDy() { return m_dy; }
-
-    int getScore()const { return m_score; }
-    int getLives() const { return m_lives; }
-    int getPower() const { return m_power; }
-    
-    void addToScore(int amount, int weight=1) { m_score += amount * weight; }
-    void loseLife(int debounce);
-    void increasePower(int value) { m_power += value; }
-    void reduceDamageDebounce();
-    void setPermanentSize(float scaleUp); // set the powerup buffs (size incr)
-    
-private:
-    int m_score = 0;
-    int m_lives = 3;
-    int m_power = 1; // mark current power lvl
-    int m_damage_debounce = 0; // frames to wait after eating
-    float m_visualScale = 1.0f; //default val to change fish size w/o changing png
-};
-
-class NPCreature : public Creature {
-public:
-    NPCreature(float x, float y, int speed, std::shared_ptr<GameSprite> sprite);
-    AquariumCreatureType GetType() {return this->m_creatureType;}
-    void move() override;
-    void draw() const override;
-protected:
-    AquariumCreatureType m_creatureType;
-
-};
-
-class BiggerFish : public NPCreature {
-public:
-    BiggerFish(float x, float y, int speed, std::shared_ptr<GameSprite> sprite);
-    void move() override;
-    void draw() const override;
-};
-
-class PinkFish : public NPCreature {
-public:
-    PinkFish(float x, float y, int speed, std::shared_ptr<GameSprite> sprite);
-    void move() override;
-    void draw() const override;
-
-    private:
-    float t = 0.0f;
-};
-
-class SharkFish : public NPCreature {
-public:
-    SharkFish(float x, float y, int speed, std::shared_ptr<GameSprite> sprite);
-    void move() override;
-    void draw() const override;
-
-    private:
-    int dashFrames = 0;       
-    int cooldownFrames = 0;
-};
-
-class AquariumSpriteManager {
-    public:
-        AquariumSpriteManager();
-        ~AquariumSpriteManager() = default;
-        std::shared_ptr<GameSprite>GetSprite(AquariumCreatureType t);
-    private:
-        std::shared_ptr<GameSprite> m_npc_fish;
-        std::shared_ptr<GameSprite> m_big_fish;
-        std::shared_ptr<GameSprite> m_pink_fish;
-        std::shared_ptr<GameSprite> m_shark_fish;
-};
-
-class PowerUp {
-public:
-    PowerUp(float x, float y, float r, std::shared_ptr<GameSprite> sprite);
-    float getX() const;
-    float getY() const;
-    float getRadius() const;
-    void draw() const;
-
-private:
-    float m_x, m_y, m_radius;
-    std::shared_ptr<GameSprite> m_sprite;
-};
-class Aquarium{
-public:
-    Aquarium(int width, int height, std::shared_ptr<AquariumSpriteManager> spriteManager);
-    void addCreature(std::shared_ptr<Creature> creature);
-    void addAquariumLevel(std::shared_ptr<AquariumLevel> level);
-    void removeCreature(std::shared_ptr<Creature> creature);
-    void clearCreatures();
-    void update();
-    void draw() const;
-    void setBounds(int w, int h) { m_width = w; m_height = h; }
-    void setMaxPopulation(int n) { m_maxPopulation = n; }
-    void Repopulate();
-    void SpawnCreature(AquariumCreatureType type);
-    void addPowerUp(std::shared_ptr<PowerUp> pu);
-    void removePowerUp(const std::shared_ptr<PowerUp>& pu);
-    
-    std::shared_ptr<Creature> getCreatureAt(int index);
-    std::shared_ptr<PowerUp> getPowerUpAt(int i);
-    int getCreatureCount() const { return m_creatures.size(); }
-    int getWidth() const { return m_width; }
-    int getHeight() const { return m_height; }
-    int getPowerUpCount() const;
-
-
-private:
-    int m_maxPopulation = 0;
-    int m_width;
-    int m_height;
-    int currentLevel = 0;
-    std::vector<std::shared_ptr<Creature>> m_creatures;
-    std::vector<std::shared_ptr<Creature>> m_next_creatures;
-    std::vector<std::shared_ptr<AquariumLevel>> m_aquariumlevels;
-    std::shared_ptr<AquariumSpriteManager> m_sprite_manager;
-    std::vector<std::shared_ptr<PowerUp>> m_powerups;
-};
-
-
-std::shared_ptr<GameEvent> DetectAquariumCollisions(std::shared_ptr<Aquarium> aquarium, std::shared_ptr<PlayerCreature> player);
-
-
-class AquariumGameScene : public GameScene {
-    public:
-        AquariumGameScene(std::shared_ptr<PlayerCreature> player, std::shared_ptr<Aquarium> aquarium, string name)
-        : m_player(std::move(player)) , m_aquarium(std::move(aquarium)), m_name(name){}
-        std::shared_ptr<GameEvent> GetLastEvent(){return m_lastEvent;}
-        void SetLastEvent(std::shared_ptr<GameEvent> event){this->m_lastEvent = event;}
-        std::shared_ptr<PlayerCreature> GetPlayer(){return this->m_player;}
-        std::shared_ptr<Aquarium> GetAquarium(){return this->m_aquarium;}
-        string GetName()override {return this->m_name;}
-        void Update() override;
-        void Draw() override;
-    private:
-        void paintAquariumHUD();
-        std::shared_ptr<PlayerCreature> m_player;
-        std::shared_ptr<Aquarium> m_aquarium;
-        std::shared_ptr<GameEvent> m_lastEvent;
-        string m_name;
-        AwaitFrames updateControl{5};
-
-        //for PowerUp
-        bool seenBigFish = false;
-        int  framesSinceBigFishSeen = 0;
-        bool spawnedSizePU = false;
-};
-
-
-class Level_0 : public AquariumLevel  {
-    public:
-        Level_0(int levelNumber, int targetScore): AquariumLevel(levelNumber, targetScore){
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::NPCreature, 10));
-
-        };
-
-};
-class Level_1 : public AquariumLevel  {
-    public:
-        Level_1(int levelNumber, int targetScore): AquariumLevel(levelNumber, targetScore){
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::NPCreature, 20));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::PinkFish, 10));
-
-        };
-
-
-};
-class Level_2 : public AquariumLevel  {
-    public:
-        Level_2(int levelNumber, int targetScore): AquariumLevel(levelNumber, targetScore){
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::NPCreature, 30));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::BiggerFish, 5));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::PinkFish, 10));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::SharkFish, 1));
-        };
-
-};
-
-class Level_3 : public AquariumLevel  {
-    public:
-        Level_3(int levelNumber, int targetScore): AquariumLevel(levelNumber, targetScore){
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::NPCreature, 27));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::BiggerFish, 6));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::PinkFish, 12));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::SharkFish, 2));
-        };
-
-};
-
-class Level_4 : public AquariumLevel  {
-    public:
-        Level_4(int levelNumber, int targetScore): AquariumLevel(levelNumber, targetScore){
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::NPCreature, 25));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::BiggerFish, 7));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::PinkFish, 13));
-            this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(AquariumCreatureType::SharkFish, 3));
-        };
-
-};
\ No newline at end of file
@@ -0,0 +1,224 @@
+#include "AquariumRender.h"
+#include "AssetLoader.h"
+#include "SpriteCache.h"
+#include "Profiler.h"
+
+
+// AquariumSpriteManager
+// by sprite id: the creatures in AquariumCreatureType order, then the power-up
+// fish face both ways so they get a mirrored copy up front
+static const SpriteKey kAquariumSprites[] = {
+    {"base-fish.png", 70, 70, true},
+    {"bigger-fish.png", 120, 120, true},
+    {"pinkFish.png", 80, 80, true},
+    {"sharkFish.png", 100, 100, true},
+    {"PowerUp.png", 32, 32, false},
+};
+static_assert(sizeof(kAquariumSprites) / sizeof(kAquariumSprites[0]) == kAquariumSpriteCount, "one sprite per creature type plus the power-up");
+static_assert(AQUARIUM_POWER_UP_SPRITE == kAquariumSpriteCount - 1, "power-up comes after the creatures");
+
+template <typename Source>
+void AquariumSpriteManager::LoadSprites(Source&& load){
+    for (int id = 0; id < kAquariumSpriteCount; ++id) {
+        this->m_sprites[id] = load(kAquariumSprites[id]);
+    }
+}
+
+AquariumSpriteManager::AquariumSpriteManager(SpriteCache& cache){
+    this->LoadSprites([&](const SpriteKey& key) { return cache.get(key); });
+    this->BuildAtlas();
+}
+
+AquariumSpriteManager::AquariumSpriteManager(AssetLoader& loader){
+    this->LoadSprites([&](const SpriteKey& key) { return loader.requestSprite(key); });
+    // until then the renderer draws sprite by sprite (and skips what isn't uploaded yet)
+    loader.onComplete([this] { this->BuildAtlas(); });
+}
+
+void AquariumSpriteManager::DeclareAssets(SpriteCache& cache, const string& scene){
+    for (const auto& key : kAquariumSprites) {
+        cache.declare(scene, key);
+    }
+}
+
+void AquariumSpriteManager::BuildAtlas() {
+    const int padding = 2; // keeps neighbours from bleeding in when sampling at the edges
+    // one horizontal strip of the creature sprites, they are all roughly square and there are only four
+    int atlasWidth = 0, atlasHeight = 0;
+    for (int i = 0; i < kAquariumCreatureTypeCount; ++i) {
+        const auto& sprite = m_sprites[i];
+        if (!sprite->isLoaded()) return; // keep drawing sprite by sprite
+        atlasWidth += (int)sprite->getWidth() + padding;
+        atlasHeight = std::max(atlasHeight, (int)sprite->getHeight());
+    }
+
+    ofPixels atlasPixels;
+    atlasPixels.allocate(atlasWidth, atlasHeight, OF_IMAGE_COLOR_ALPHA);
+    atlasPixels.set(0);
+    int x = 0;
+    std::vector<int> offsets;
+    for (int i = 0; i < kAquariumCreatureTypeCount; ++i) {
+        const auto& sprite = m_sprites[i];
+        ofPixels pixels = sprite->getPixels();
+        pixels.setImageType(OF_IMAGE_COLOR_ALPHA);
+        pixels.pasteInto(atlasPixels, x, 0);
+        offsets.push_back(x);
+        x += (int)sprite->getWidth() + padding;
+    }
+    m_atlas.loadData(atlasPixels);
+
+    // texture coordinates depend on whether OF uses rectangle textures, let the texture say
+    for (int i = 0; i < kAquariumCreatureTypeCount; ++i) {
+        AtlasRegion& region = m_regions[i];
+        region.width = m_sprites[i]->getWidth();
+        region.height = m_sprites[i]->getHeight();
+        region.uvMin = m_atlas.getCoordFromPoint(offsets[i], 0);
+        region.uvMax = m_atlas.getCoordFromPoint(offsets[i] + region.width, region.height);
+    }
+}
+
+void AquariumSpriteManager::BeginBatch() {
+    m_batch.clear(); // keeps the vertex storage from the last frame
+    m_batch.setMode(OF_PRIMITIVE_TRIANGLES);
+}
+
+void AquariumSpriteManager::AddToBatch(SpriteId id, float x, float y, bool flipped) {
+    const AtlasRegion& region = m_regions[id];
+    float x1 = x + region.width;
+    float y1 = y + region.height;
+    // mirroring is just swapping the horizontal texture coordinates
+    float u0 = flipped ? region.uvMax.x : region.uvMin.x;
+    float u1 = flipped ? region.uvMin.x : region.uvMax.x;
+    float v0 = region.uvMin.y;
+    float v1 = region.uvMax.y;
+
+    m_batch.addVertex(glm::vec3(x, y, 0));   m_batch.addTexCoord(glm::vec2(u0, v0));
+    m_batch.addVertex(glm::vec3(x1, y, 0));  m_batch.addTexCoord(glm::vec2(u1, v0));
+    m_batch.addVertex(glm::vec3(x1, y1, 0)); m_batch.addTexCoord(glm::vec2(u1, v1));
+    m_batch.addVertex(glm::vec3(x, y, 0));   m_batch.addTexCoord(glm::vec2(u0, v0));
+    m_batch.addVertex(glm::vec3(x1, y1, 0)); m_batch.addTexCoord(glm::vec2(u1, v1));
+    m_batch.addVertex(glm::vec3(x, y1, 0));  m_batch.addTexCoord(glm::vec2(u0, v1));
+}
+
+void AquariumSpriteManager::DrawBatch() {
+    if (m_batch.getNumVertices() == 0) return;
+    m_atlas.bind();
+    m_batch.draw();
+    m_atlas.unbind();
+    DrawCallCounter::add();
+}
+
+std::shared_ptr<GameSprite> AquariumSpriteManager::GetSprite(SpriteId id) const {
+    if (id >= kAquariumSpriteCount) return nullptr;
+    return this->m_sprites[id];
+}
+
+// AquariumRenderer
+void AquariumRenderer::draw(const AquariumGameScene& scene) {
+    // player and aquarium both step every tick, so they share the alpha
+    this->drawPlayer(*scene.GetPlayer(), scene.GetInterpolation());
+    this->drawCreatures(*scene.GetAquarium(), scene.GetInterpolation());
+    this->paintHUD(scene);
+}
+
+void AquariumRenderer::drawPlayer(const PlayerCreature& player, float alpha) const {
+    if (player.getDamageDebounce() > 0) {
+        ofSetColor(ofColor::red); // Flash red if in damage debounce
+    }
+    auto sprite = m_sprites->GetSprite(player.getSprite());
+    if (sprite) { //incr size after pu
+        ofPushMatrix();
+        ofTranslate(player.getRenderX(alpha), player.getRenderY(alpha));
+        ofScale(player.getVisualScale(), player.getVisualScale());
+        sprite->draw(0, 0, player.isFlipped());
+        ofPopMatrix();
+    }
+    ofSetColor(ofColor::white); // Reset color
+}
+
+void AquariumRenderer::drawCreatures(const Aquarium& aquarium, float alpha) const {
+    AQ_PROFILE_SCOPE("AquariumRenderer::drawCreatures");
+    if (this->isBatchedDrawing()) {
+        this->drawBatched(aquarium, alpha);
+    } else if (aquarium.getStorage() == CreatureStorage::Arrays) {
+        this->drawArrays(aquarium, alpha);
+    } else {
+        // aquarium order like the store, so both storage modes overlap fish the same way
+        ofSetColor(ofColor::white);
+        for (const auto& creature : aquarium.getAllCreatures()) {
+            auto sprite = m_sprites->GetSprite(creature->getSprite());
+            if (sprite) sprite->draw(creature->getRenderX(alpha), creature->getRenderY(alpha), creature->isFlipped());
+        }
+    }
+    for (const auto& pu : aquarium.getPowerUps()) {
+        auto sprite = m_sprites->GetSprite(pu->getSprite());
+        if (sprite) sprite->draw(pu->getX(), pu->getY()); //power Ups drawn AFTER CREATURE!!!!!
+    }
+}
+
+// the store has no sprite column, a stored creature looks like its type
+void AquariumRenderer::drawArrays(const Aquarium& aquarium, float alpha) const {
+    // one sprite lookup per type instead of per creature
+    std::shared_ptr<GameSprite> sprites[kAquariumCreatureTypeCount];
+    for (int t = 0; t < kAquariumCreatureTypeCount; ++t) {
+        sprites[t] = m_sprites->GetSprite(AquariumCreatureSprite((AquariumCreatureType)t));
+    }
+    ofSetColor(ofColor::white);
+    const CreatureStore& s = aquarium.getStore();
+    for (int i = 0; i < s.size(); ++i) {
+        const auto& sprite = sprites[s.type[i]];
+        if (!sprite) continue;
+        float x = s.prevX[i] + (s.x[i] - s.prevX[i]) * alpha;
+        float y = s.prevY[i] + (s.y[i] - s.prevY[i]) * alpha;
+        sprite->draw(x, y, s.flipped[i]);
+    }
+}
+
+// one mesh for the whole aquarium, works the same for both storage modes
+void AquariumRenderer::drawBatched(const Aquarium& aquarium, float alpha) const {
+    AquariumSpriteManager& sprites = *m_sprites;
+    sprites.BeginBatch();
+    if (aquarium.getStorage() == CreatureStorage::Arrays) {
+        const CreatureStore& s = aquarium.getStore();
+        for (int i = 0; i < s.size(); ++i) {
+            float x = s.prevX[i] + (s.x[i] - s.prevX[i]) * alpha;
+            float y = s.prevY[i] + (s.y[i] - s.prevY[i]) * alpha;
+            sprites.AddToBatch(AquariumCreatureSprite((AquariumCreatureType)s.type[i]), x, y, s.flipped[i]);
+        }
+    } else {
+        for (const auto& creature : aquarium.getAllCreatures()) {
+            sprites.AddToBatch(creature->getSprite(), creature->getRenderX(alpha), creature->getRenderY(alpha), creature->isFlipped());
+        }
+    }
+    ofSetColor(ofColor::white);
+    sprites.DrawBatch();
+}
+
+void AquariumRenderer::paintHUD(const AquariumGameScene& scene) const {
+    const PlayerCreature& player = *scene.GetPlayer();
+    const Aquarium& aquarium = *scene.GetAquarium();
+    float panelWidth = ofGetWindowWidth() - 150;
+    // Draw basic HUD
+    ofDrawBitmapString("Score: " + std::to_string(player.getScore()), panelWidth, 20);
+    ofDrawBitmapString("Power: " + std::to_string(player.getPower()), panelWidth, 30);
+    ofDrawBitmapString("Lives: " + std::to_string(player.getLives()), panelWidth, 40);
+    // Lightweight FPS counter for runtime profiling
+    int fps = (int)ofGetFrameRate();
+    ofDrawBitmapString("FPS: " + std::to_string(fps), 10, 20);
+    if (scene.IsDebugOverlayVisible()) {
+        ofDrawBitmapString("Frame: " + ofToString(ofGetLastFrameTime() * 1000.0, 2) + " ms"
+                           + (GameSprite::GetUseMirrorCache() ? " (mirror cache)" : " (matrix flip)"), 10, 65);
+        ofDrawBitmapString("Draw calls: " + std::to_string(DrawCallCounter::get()), 10, 35);
+        ofDrawBitmapString("Creatures: " + std::to_string(aquarium.getCreatureCount())
+                           + (this->isBatchedDrawing() ? " (batched)" : " (per sprite)"), 10, 50);
+        ofDrawBitmapString("Base " + std::to_string(aquarium.getCreatureCount(AquariumCreatureType::NPCreature))
+                           + "  Big " + std::to_string(aquarium.getCreatureCount(AquariumCreatureType::BiggerFish))
+                           + "  Pink " + std::to_string(aquarium.getCreatureCount(AquariumCreatureType::PinkFish))
+                           + "  Shark " + std::to_string(aquarium.getCreatureCount(AquariumCreatureType::SharkFish)), 10, 80);
+    }
+    for (int i = 0; i < player.getLives(); ++i) {
+        ofSetColor(ofColor::red);
+        ofDrawCircle(panelWidth + i * 20, 50, 5);
+    }
+    ofSetColor(ofColor::white); // Reset color to white for other drawings
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include "ofMain.h"
+#include "Aquarium.h"
+#include "GameRender.h"
+
+class AssetLoader;
+class SpriteCache;
+
+// The images behind the aquarium's sprite ids (AquariumCreatureSprite, AQUARIUM_POWER_UP_SPRITE).
+class AquariumSpriteManager {
+    public:
+        // sprites come from the cache, anything not already in it is decoded right away
+        explicit AquariumSpriteManager(SpriteCache& cache);
+        // decodes in the background instead, the atlas gets built once the loader is done
+        explicit AquariumSpriteManager(AssetLoader& loader);
+        // adds every sprite the aquarium draws to the scene's preload manifest
+        static void DeclareAssets(SpriteCache& cache, const string& scene);
+        ~AquariumSpriteManager() = default;
+        // null for NO_SPRITE or an id the aquarium doesn't hand out
+        std::shared_ptr<GameSprite> GetSprite(SpriteId id) const;
+
+        // every creature sprite is also packed into one atlas texture at startup so a whole
+        // aquarium can go out as a single mesh: Begin, Add each creature, then Draw once
+        bool HasAtlas() const { return m_atlas.isAllocated(); }
+        void BeginBatch();
+        void AddToBatch(SpriteId id, float x, float y, bool flipped); // creature sprites only
+        void DrawBatch();
+        int GetBatchSize() const { return (int)m_batch.getNumVertices() / 6; }
+    private:
+        void BuildAtlas();
+        template <typename Source> void LoadSprites(Source&& load);
+
+        std::shared_ptr<GameSprite> m_sprites[kAquariumSpriteCount]; // by sprite id
+
+        // where each creature sprite lives inside the atlas
+        struct AtlasRegion {
+            float width = 0;
+            float height = 0;
+            glm::vec2 uvMin;
+            glm::vec2 uvMax;
+        };
+        ofTexture m_atlas;
+        AtlasRegion m_regions[kAquariumCreatureTypeCount];
+        ofMesh m_batch;
+};
+
+// Draws an AquariumGameScene with openFrameworks: the player, every creature (straight from
+// the store with array storage), the power-ups and the HUD. It only reads the scene, so the
+// simulation doesn't know it exists.
+class AquariumRenderer : public AquariumSceneRenderer {
+    public:
+        explicit AquariumRenderer(std::shared_ptr<AquariumSpriteManager> sprites)
+        : m_sprites(std::move(sprites)) {}
+        void draw(const AquariumGameScene& scene) override;
+        // every creature as one atlas mesh once the sprite manager has an atlas (default on)
+        void setBatchedDrawing(bool batched) { m_batchedDrawing = batched; }
+        bool isBatchedDrawing() const { return m_batchedDrawing && m_sprites->HasAtlas(); }
+    private:
+        void drawPlayer(const PlayerCreature& player, float alpha) const;
+        void drawCreatures(const Aquarium& aquarium, float alpha) const;
+        void drawArrays(const Aquarium& aquarium, float alpha) const;
+        void drawBatched(const Aquarium& aquarium, float alpha) const;
+        void paintHUD(const AquariumGameScene& scene) const;
+
+        std::shared_ptr<AquariumSpriteManager> m_sprites;
+        bool m_batchedDrawing = true;
+};
@@ -0,0 +1,120 @@
+#include "AssetLoader.h"
+
+
+AssetLoader::AssetLoader(SpriteCache& cache, int threadCount) : m_cache(cache) {
+    for (int i = 0; i < std::max(threadCount, 1); ++i) {
+        m_threads.emplace_back(&AssetLoader::workerLoop, this);
+    }
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+        m_decodeQueue.clear(); // nobody is waiting on them anymore
+    }
+    m_wake.notify_all();
+    for (auto& t : m_threads) t.join();
+}
+
+std::shared_ptr<GameSprite> AssetLoader::requestSprite(const std::string& path, int width, int height, bool cacheMirrored) {
+    return this->requestSprite(SpriteKey{path, width, height, cacheMirrored});
+}
+
+std::shared_ptr<GameSprite> AssetLoader::requestSprite(const SpriteKey& key) {
+    return this->request(key, false);
+}
+
+std::shared_ptr<GameSprite> AssetLoader::request(const SpriteKey& key, bool preload) {
+    if (auto cached = m_cache.find(key)) return cached;
+    // cached right away so a second request while this one decodes shares the sprite
+    auto sprite = std::make_shared<GameSprite>(key.cacheMirrored);
+    m_cache.insert(key, sprite, preload);
+    SpriteJob job;
+    job.path = key.path;
+    job.width = key.width;
+    job.height = key.height;
+    job.sprite = sprite;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_decodeQueue.push_back(std::move(job));
+    }
+    m_wake.notify_one();
+    ++m_total;
+    return sprite;
+}
+
+void AssetLoader::preloadScene(const std::string& scene) {
+    for (const auto& key : m_cache.getManifest(scene)) {
+        this->request(key, true);
+    }
+}
+
+void AssetLoader::requestOnMainThread(const std::string& name, std::function<void()> load) {
+    m_mainQueue.emplace_back(name, std::move(load));
+    ++m_total;
+}
+
+void AssetLoader::onComplete(std::function<void()> fn) {
+    if (this->isDone()) {
+        fn();
+        return;
+    }
+    m_completion.push_back(std::move(fn));
+}
+
+void AssetLoader::workerLoop() {
+    while (true) {
+        SpriteJob job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [this] { return m_stop || !m_decodeQueue.empty(); });
+            if (m_stop) return;
+            job = std::move(m_decodeQueue.front());
+            m_decodeQueue.pop_front();
+        }
+        job.ok = GameSprite::Decode(job.path, job.width, job.height, job.pixels);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_uploadQueue.push_back(std::move(job));
+    }
+}
+
+void AssetLoader::update(float budgetMs) {
+    if (this->isDone()) return;
+    uint64_t start = ofGetElapsedTimeMicros();
+    auto budgetLeft = [&] { return (ofGetElapsedTimeMicros() - start) < (uint64_t)(budgetMs * 1000.0f); };
+
+    // uploads first, they're cheap next to a font or a sound file
+    do {
+        SpriteJob job;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_uploadQueue.empty()) break;
+            job = std::move(m_uploadQueue.front());
+            m_uploadQueue.pop_front();
+        }
+        if (!job.ok) {
+            ofLogError("AssetLoader") << "Failed to load image: " << job.path;
+        }
+        size_t before = job.sprite->getResidentBytes();
+        job.sprite->setPixels(job.pixels);
+        m_cache.addBytes(job.sprite->getResidentBytes() - before);
+        m_currentName = job.path;
+        ++m_finished;
+    } while (budgetLeft());
+
+    while (!m_mainQueue.empty() && budgetLeft()) {
+        auto item = std::move(m_mainQueue.front());
+        m_mainQueue.pop_front();
+        m_currentName = item.first;
+        item.second();
+        ++m_finished;
+    }
+
+    if (this->isDone()) {
+        ofLogNotice("AssetLoader") << m_total << " assets loaded";
+        auto callbacks = std::move(m_completion);
+        m_completion.clear();
+        for (auto& fn : callbacks) fn();
+    }
+}
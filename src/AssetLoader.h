@@ -0,0 +1,72 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "ofMain.h"
+#include "GameRender.h"
+#include "SpriteCache.h"
+
+// Loads the game's assets without stalling the first frame. Image decode and resize run on
+// background threads into ofPixels; everything that needs the GL context (texture upload,
+// fonts) or the sound system is queued and run from update() on the main thread, a little
+// per frame. Sprites handed out by requestSprite draw nothing until their upload happened.
+// Sprites go through the SpriteCache, asking twice for the same image only decodes it once.
+class AssetLoader {
+public:
+    explicit AssetLoader(SpriteCache& cache, int threadCount = 2);
+    ~AssetLoader();
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // queues a decode unless the cache has it, the returned sprite fills in once update() uploads it
+    std::shared_ptr<GameSprite> requestSprite(const std::string& path, int width, int height, bool cacheMirrored = false);
+    std::shared_ptr<GameSprite> requestSprite(const SpriteKey& key);
+    // requests everything the scene declared in the cache's manifest
+    void preloadScene(const std::string& scene);
+    // queues work that has to happen on the main thread, e.g. fonts and sound
+    void requestOnMainThread(const std::string& name, std::function<void()> load);
+    // runs once after everything queued so far has finished
+    void onComplete(std::function<void()> fn);
+
+    // main thread: uploads finished decodes and runs main thread loads until the
+    // budget is spent (at least one item per call so loading always moves forward)
+    void update(float budgetMs = 4.0f);
+
+    int getTotal() const { return m_total; }
+    int getFinished() const { return m_finished; }
+    float getProgress() const { return m_total == 0 ? 1.0f : (float)m_finished / (float)m_total; }
+    bool isDone() const { return m_finished == m_total; }
+    const std::string& getCurrentName() const { return m_currentName; }
+
+private:
+    struct SpriteJob {
+        std::string path;
+        int width = 0;
+        int height = 0;
+        std::shared_ptr<GameSprite> sprite;
+        ofPixels pixels;
+        bool ok = false;
+    };
+
+    std::shared_ptr<GameSprite> request(const SpriteKey& key, bool preload);
+    void workerLoop();
+
+    SpriteCache& m_cache;
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::deque<SpriteJob> m_decodeQueue; // waiting for a worker
+    std::deque<SpriteJob> m_uploadQueue; // decoded, waiting for the main thread
+    bool m_stop = false;
+
+    // main thread only from here on
+    std::deque<std::pair<std::string, std::function<void()>>> m_mainQueue;
+    std::vector<std::function<void()>> m_completion;
+    int m_total = 0;
+    int m_finished = 0;
+    std::string m_currentName;
+};
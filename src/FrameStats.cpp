@@ -0,0 +1,103 @@
+#include "FrameStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+
+void RollingHistogram::add(float value) {
+    if (m_size == WINDOW) {
+        float oldest = m_samples[m_next];
+        m_counts[this->binOf(oldest)]--;
+        m_sum -= oldest;
+    } else {
+        m_size++;
+    }
+    value = std::max(value, 0.0f);
+    m_samples[m_next] = value;
+    m_counts[this->binOf(value)]++;
+    m_sum += value;
+    m_next = (m_next + 1) % WINDOW;
+}
+
+float RollingHistogram::percentile(float p) const {
+    if (m_size == 0) return 0.0f;
+    int rank = std::max(1, (int)std::ceil(p * m_size));
+    int seen = 0;
+    for (int bin = 0; bin < BINS; ++bin) {
+        seen += m_counts[bin];
+        if (seen >= rank) return (bin + 1) * m_binWidth;
+    }
+    return BINS * m_binWidth;
+}
+
+float RollingHistogram::max() const {
+    // exact, the top bin is open ended and the spikes are the interesting part
+    float highest = 0.0f;
+    for (int i = 0; i < m_size; ++i) highest = std::max(highest, m_samples[i]);
+    return highest;
+}
+
+
+FrameStats::FrameStats() {
+    for (auto& line : m_lines) line.reserve(96);
+}
+
+void FrameStats::beginFrame(float frameSeconds) {
+    uint64_t allocations = AllocationCounter::get();
+    m_frame.add(frameSeconds * 1000.0f);
+    m_allocations.add((float)(allocations - m_lastAllocations));
+    m_lastAllocations = allocations;
+    m_framesSinceRefresh++;
+}
+
+void FrameStats::setSubsystemTotals(int creatures, uint64_t added, uint64_t removed, uint64_t collisionTests, uint64_t collisionPasses) {
+    m_creatures = creatures;
+    m_totals[0] = added;
+    m_totals[1] = removed;
+    m_totals[2] = collisionTests;
+    m_totals[3] = collisionPasses;
+}
+
+void FrameStats::refresh() {
+    uint64_t now = ofGetElapsedTimeMicros();
+    double seconds = std::max((now - m_lastRefreshUs) / 1e6, 1e-6);
+    uint64_t delta[4];
+    for (int i = 0; i < 4; ++i) {
+        delta[i] = m_totals[i] - std::min(m_lastTotals[i], m_totals[i]);
+        m_lastTotals[i] = m_totals[i];
+    }
+    m_lastRefreshUs = now;
+    m_framesSinceRefresh = 0;
+
+    char buffer[128];
+    auto set = [&](int line) { m_lines[line].assign(buffer); };
+    std::snprintf(buffer, sizeof(buffer), "frame  p50 %5.1f  p95 %5.1f  p99 %5.1f  max %5.1f ms",
+                  m_frame.percentile(0.50f), m_frame.percentile(0.95f), m_frame.percentile(0.99f), m_frame.max());
+    set(0);
+    std::snprintf(buffer, sizeof(buffer), "update avg %5.2f  p95 %5.2f  max %5.2f ms",
+                  m_update.mean(), m_update.percentile(0.95f), m_update.max());
+    set(1);
+    std::snprintf(buffer, sizeof(buffer), "draw   avg %5.2f  p95 %5.2f  max %5.2f ms",
+                  m_draw.mean(), m_draw.percentile(0.95f), m_draw.max());
+    set(2);
+    std::snprintf(buffer, sizeof(buffer), "creatures %d  spawns %.0f/s  removals %.0f/s",
+                  m_creatures, delta[0] / seconds, delta[1] / seconds);
+    set(3);
+    std::snprintf(buffer, sizeof(buffer), "collision candidates %.1f per pass",
+                  delta[3] ? (double)delta[2] / delta[3] : 0.0);
+    set(4);
+    std::snprintf(buffer, sizeof(buffer), "allocations/frame avg %.1f  max %.0f",
+                  m_allocations.mean(), m_allocations.max());
+    set(5);
+}
+
+void FrameStats::draw(float x, float y) {
+    if (!m_visible) return;
+    if (m_framesSinceRefresh >= 15 || m_lines[0].empty()) this->refresh(); // 4 times a second at 60 fps
+    ofSetColor(0, 0, 0, 160);
+    ofDrawRectangle(x - 4, y - 12, 420, LINES * 14 + 6);
+    ofSetColor(ofColor::white);
+    for (int i = 0; i < LINES; ++i) {
+        ofDrawBitmapString(m_lines[i], x, y + i * 14);
+    }
+}
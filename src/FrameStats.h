@@ -0,0 +1,78 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include "ofMain.h"
+
+// Rolling window of the last WINDOW samples in BINS fixed width bins (0.1 ms for frame
+// times). Adding a sample drops the oldest one, so percentiles always describe the last
+// few seconds and nothing is allocated after construction.
+class RollingHistogram {
+public:
+    static const int BINS = 1000;   // the last one also holds everything above BINS * binWidth
+    static const int WINDOW = 600;  // ~10 s at 60 fps
+
+    explicit RollingHistogram(float binWidth = 0.1f) : m_binWidth(binWidth) {}
+    void add(float value);
+    // upper edge of the bin holding the p-th sample, p in [0, 1]
+    float percentile(float p) const;
+    float max() const;
+    float mean() const { return m_size ? (float)(m_sum / m_size) : 0.0f; }
+    int size() const { return m_size; }
+
+private:
+    int binOf(float value) const { return std::min((int)(value / m_binWidth), BINS - 1); }
+
+    float m_binWidth;
+    uint16_t m_counts[BINS] = {};
+    float m_samples[WINDOW] = {};
+    int m_next = 0;
+    int m_size = 0;
+    double m_sum = 0;
+};
+
+// Process wide count of operator new calls, see AllocationCounter.cpp. Stays at zero
+// when AQUARIUM_COUNT_ALLOCATIONS is 0.
+class AllocationCounter {
+public:
+    static uint64_t get();
+};
+
+// Toggleable performance overlay ('f'): frame, update and draw time percentiles plus the
+// subsystem counters fed in by ofApp. The text is only rebuilt a few times a second into
+// strings that keep their capacity, so showing it costs next to nothing.
+class FrameStats {
+public:
+    FrameStats();
+
+    // once per frame, before anything else in update
+    void beginFrame(float frameSeconds);
+    void addUpdateTime(float ms) { m_update.add(ms); }
+    void addDrawTime(float ms) { m_draw.add(ms); }
+    // totals as of now, rates are worked out from the difference between refreshes
+    void setSubsystemTotals(int creatures, uint64_t added, uint64_t removed, uint64_t collisionTests, uint64_t collisionPasses);
+
+    void toggle() { m_visible = !m_visible; }
+    bool isVisible() const { return m_visible; }
+    void draw(float x, float y);
+
+private:
+    void refresh();
+
+    RollingHistogram m_frame;
+    RollingHistogram m_update;
+    RollingHistogram m_draw;
+    RollingHistogram m_allocations{1.0f}; // operator new calls per frame
+
+    uint64_t m_lastAllocations = 0;
+    int m_creatures = 0;
+    uint64_t m_totals[4] = {};      // added, removed, tests, passes
+    uint64_t m_lastTotals[4] = {};  // at the previous refresh
+    uint64_t m_lastRefreshUs = 0;
+    int m_framesSinceRefresh = 0;
+    bool m_visible = false;
+
+    static const int LINES = 6;
+    std::string m_lines[LINES];
+};
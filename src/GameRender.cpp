@@ -0,0 +1,33 @@
+#include "GameRender.h"
+
+
+int DrawCallCounter::s_count = 0;
+bool GameSprite::s_useMirrorCache = true;
+
+void GameIntroScene::Update(){
+
+}
+
+void GameIntroScene::Draw(){
+    this->m_banner->draw(0,0);
+    if (!this->IsLoading()) return;
+
+    float barWidth = ofGetWindowWidth() * 0.5f;
+    float barX = (ofGetWindowWidth() - barWidth) * 0.5f;
+    float barY = ofGetWindowHeight() - 60.0f;
+    ofSetColor(0, 0, 0, 160);
+    ofDrawRectangle(barX, barY, barWidth, 12);
+    ofSetColor(ofColor::white);
+    ofDrawRectangle(barX, barY, barWidth * this->m_loadProgress, 12);
+    ofDrawBitmapString("Loading " + this->m_loadingName, barX, barY - 8);
+}
+
+void GameOverScene::Update(){
+
+}
+
+void GameOverScene::Draw(){
+    ofBackgroundGradient(ofColor::red, ofColor::black);
+    this->m_banner->draw(0,0);
+
+}
\ No newline at end of file
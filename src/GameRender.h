@@ -0,0 +1,132 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include "ofMain.h"
+#include "Core.h"
+
+// The openFrameworks side of the game: sprites and the scenes that are nothing but a banner.
+// None of it is needed to run the simulation, see Core.h for that.
+
+// Draw calls issued so far this frame, reset at the top of ofApp::draw and shown in the debug HUD.
+class DrawCallCounter {
+public:
+    static void reset() { s_count = 0; }
+    static void add(int calls = 1) { s_count += calls; }
+    static int get() { return s_count; }
+private:
+    static int s_count;
+};
+
+class GameSprite {
+public:
+    // cacheMirrored keeps a horizontally mirrored copy next to the image so flipped draws are
+    // a plain texture draw instead of a push/translate/scale/pop around every call
+    GameSprite(const std::string& imagePath, int width, int height, bool cacheMirrored = false)
+    : m_cacheMirrored(cacheMirrored) {
+        ofPixels pixels;
+        if (!Decode(imagePath, width, height, pixels)) {
+            std::cerr << "Failed to load image: " << imagePath << std::endl;
+        }
+        this->setPixels(pixels);
+    }
+
+    // empty sprite filled in later with setPixels, draws nothing until then (see AssetLoader)
+    explicit GameSprite(bool cacheMirrored = false)
+    : m_cacheMirrored(cacheMirrored) {}
+
+    // file read, decode and resize only touch ofPixels so this is safe off the main thread
+    static bool Decode(const std::string& imagePath, int width, int height, ofPixels& out) {
+        if (!ofLoadImage(out, imagePath)) return false;
+        out.resize(width, height);
+        return true;
+    }
+
+    // uploads already decoded pixels, main thread only since it creates the textures
+    void setPixels(const ofPixels& pixels) {
+        if (!pixels.isAllocated()) return;
+        m_image.setFromPixels(pixels);
+        if (m_cacheMirrored) {
+            ofPixels mirrored = pixels;
+            mirrored.mirror(false, true);
+            m_mirrored.setFromPixels(mirrored);
+        }
+    }
+
+
+    // draw supports a flipped parameter so the same GameSprite instance
+    // can be shared across creatures without storing mutable state.
+    void draw(float x, float y, bool flipped = false) const {
+        if (!m_image.isAllocated()) return;
+        DrawCallCounter::add();
+        if (!flipped) {
+            m_image.draw(x, y);
+        } else if (s_useMirrorCache && m_mirrored.isAllocated()) {
+            m_mirrored.draw(x, y);
+        } else {
+            // draw mirrored horizontally without creating a flipped copy
+            ofPushMatrix();
+            ofTranslate(x + m_image.getWidth(), y);
+            ofScale(-1, 1);
+            m_image.draw(0, 0);
+            ofPopMatrix();
+        }
+    }
+
+    // stretched to width x height at draw time, the sprite itself is shared through the
+    // SpriteCache so it never gets resized in place
+    void draw(float x, float y, float width, float height) const {
+        if (!m_image.isAllocated()) return;
+        DrawCallCounter::add();
+        m_image.draw(x, y, width, height);
+    }
+
+    // global switch so the two flipped paths can be compared at runtime
+    static void SetUseMirrorCache(bool use) { s_useMirrorCache = use; }
+    static bool GetUseMirrorCache() { return s_useMirrorCache; }
+    bool hasMirrorCache() const { return m_mirrored.isAllocated(); }
+
+    float getWidth() const { return m_image.getWidth(); }
+    float getHeight() const { return m_image.getHeight(); }
+    bool isLoaded() const { return m_image.isAllocated(); }
+    size_t getResidentBytes() const {
+        return m_image.getPixels().getTotalBytes() + m_mirrored.getPixels().getTotalBytes();
+    }
+    const ofPixels& getPixels() const { return m_image.getPixels(); }
+
+private:
+    bool m_cacheMirrored;
+    ofImage m_image;
+    ofImage m_mirrored;
+    static bool s_useMirrorCache;
+};
+
+class GameIntroScene : public GameScene {
+    public:
+        GameIntroScene(string name, std::shared_ptr<GameSprite> banner)
+        : m_name(name), m_banner(std::move(banner)){};
+        string GetName() override {return this->m_name;}
+        void Update() override;
+        void Draw() override;
+        // assets still loading in the background, a bar is drawn until progress reaches 1
+        void SetLoadProgress(float progress, string current) { m_loadProgress = progress; m_loadingName = std::move(current); }
+        bool IsLoading() const { return m_loadProgress < 1.0f; }
+    private:
+        string m_name;
+        std::shared_ptr<GameSprite> m_banner;
+        float m_loadProgress = 1.0f;
+        string m_loadingName;
+};
+
+class GameOverScene : public GameScene {
+    public:
+        GameOverScene(string name, std::shared_ptr<GameSprite> banner)
+        : m_name(name), m_banner(std::move(banner)){};
+        string GetName() override {return this->m_name;}
+        void Update() override;
+        void Draw() override;
+    private:
+        string m_name;
+        std::shared_ptr<GameSprite> m_banner;
+};
@@ -0,0 +1,63 @@
+#include "SpriteCache.h"
+
+
+std::shared_ptr<GameSprite> SpriteCache::get(const std::string& path, int width, int height, bool cacheMirrored) {
+    return this->get(SpriteKey{path, width, height, cacheMirrored});
+}
+
+std::shared_ptr<GameSprite> SpriteCache::get(const SpriteKey& key) {
+    if (auto sprite = this->find(key)) return sprite;
+    this->countMiss(key);
+    auto sprite = std::make_shared<GameSprite>(key.path, key.width, key.height, key.cacheMirrored);
+    m_bytes += sprite->getResidentBytes();
+    m_sprites[key] = sprite;
+    return sprite;
+}
+
+std::shared_ptr<GameSprite> SpriteCache::find(const SpriteKey& key) {
+    auto it = m_sprites.find(key);
+    if (it == m_sprites.end()) return nullptr;
+    ++m_hits;
+    return it->second;
+}
+
+void SpriteCache::insert(const SpriteKey& key, std::shared_ptr<GameSprite> sprite, bool preload) {
+    if (preload) {
+        ++m_preloads;
+    } else {
+        this->countMiss(key);
+    }
+    m_bytes += sprite->getResidentBytes();
+    m_sprites[key] = std::move(sprite);
+}
+
+void SpriteCache::countMiss(const SpriteKey& key) {
+    ++m_misses;
+    int& sceneMisses = m_sceneMisses[m_activeScene];
+    ++sceneMisses;
+    const auto& manifest = this->getManifest(m_activeScene);
+    if (!manifest.empty()) {
+        // the scene said what it needs, anything else means a decode mid scene
+        ofLogWarning("SpriteCache") << key.path << " " << key.width << "x" << key.height
+                                    << " not preloaded, loading during " << m_activeScene;
+    }
+}
+
+void SpriteCache::declare(const std::string& scene, const SpriteKey& key) {
+    auto& manifest = m_manifests[scene];
+    for (const auto& existing : manifest) {
+        if (!(existing < key) && !(key < existing)) return;
+    }
+    manifest.push_back(key);
+}
+
+const std::vector<SpriteKey>& SpriteCache::getManifest(const std::string& scene) const {
+    static const std::vector<SpriteKey> empty;
+    auto it = m_manifests.find(scene);
+    return it == m_manifests.end() ? empty : it->second;
+}
+
+int SpriteCache::getSceneMisses(const std::string& scene) const {
+    auto it = m_sceneMisses.find(scene);
+    return it == m_sceneMisses.end() ? 0 : it->second;
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <tuple>
+#include <vector>
+#include "ofMain.h"
+#include "GameRender.h"
+
+// One resized image on disk, what a sprite is cached under. cacheMirrored is part of the key
+// since a sprite built without the mirrored copy can't grow one later.
+struct SpriteKey {
+    std::string path;
+    int width = 0;
+    int height = 0;
+    bool cacheMirrored = false;
+
+    bool operator<(const SpriteKey& other) const {
+        return std::tie(path, width, height, cacheMirrored)
+             < std::tie(other.path, other.width, other.height, other.cacheMirrored);
+    }
+};
+
+// Every GameSprite the game draws comes out of here, so each image is decoded once and shared.
+// Scenes declare what they need up front and the AssetLoader preloads those, anything else
+// is a miss that decodes right there on the calling thread. Misses are counted per scene so
+// a gameplay scene can be checked for disk access. Main thread only.
+class SpriteCache {
+public:
+    // hit returns the cached sprite (possibly still being loaded), miss decodes synchronously
+    std::shared_ptr<GameSprite> get(const std::string& path, int width, int height, bool cacheMirrored = false);
+    std::shared_ptr<GameSprite> get(const SpriteKey& key);
+    // lookup without loading, counts a hit when found; the loader fills in misses itself
+    std::shared_ptr<GameSprite> find(const SpriteKey& key);
+    // preload marks sprites a scene declared, those are counted apart from misses
+    void insert(const SpriteKey& key, std::shared_ptr<GameSprite> sprite, bool preload = false);
+    // a cached sprite got its pixels after insert (AssetLoader uploads), keeps getBytes current
+    void addBytes(size_t bytes) { m_bytes += bytes; }
+
+    // preload manifest per scene name, see AssetLoader::preloadScene
+    void declare(const std::string& scene, const SpriteKey& key);
+    const std::vector<SpriteKey>& getManifest(const std::string& scene) const;
+
+    // misses from here on are charged to this scene
+    void setActiveScene(const std::string& scene) { m_activeScene = scene; }
+    const std::string& getActiveScene() const { return m_activeScene; }
+
+    int getHits() const { return m_hits; }
+    int getMisses() const { return m_misses; }
+    int getPreloads() const { return m_preloads; }
+    int getSceneMisses(const std::string& scene) const;
+    int size() const { return (int)m_sprites.size(); }
+    size_t getBytes() const { return m_bytes; } // decoded pixel memory held by cached sprites
+
+private:
+    void countMiss(const SpriteKey& key);
+
+    std::map<SpriteKey, std::shared_ptr<GameSprite>> m_sprites;
+    std::map<std::string, std::vector<SpriteKey>> m_manifests;
+    std::map<std::string, int> m_sceneMisses;
+    std::string m_activeScene;
+    int m_hits = 0;
+    int m_misses = 0;
+    int m_preloads = 0;
+    size_t m_bytes = 0; // running total, sprites only ever get added
+};
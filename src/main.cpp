@@ -1,8 +1,13 @@
 #include "ofMain.h"
 #include "ofApp.h"
+#include "HeadlessRunner.h"
 
 //========================================================================
-int main( ){
+int main(int argc, char* argv[]){
+
+	// command line tools that run without opening a window, see RunCommandLineTool
+	int exitCode = 0;
+	if (RunCommandLineTool(argc, argv, exitCode)) return exitCode;
 
 	//Use ofGLFWWindowSettings for more options like multi-monitor fullscreen
 	ofGLWindowSettings settings;
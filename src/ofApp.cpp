@@ -1,89 +1,150 @@
 #include "ofApp.h"
-
+#include "Profiler.h"
+#include "Log.h"
+#include "LevelPack.h"
+#include "Snapshot.h"
+
+// the simulation's log lines go through ofLog like the rest of the game's
+static void LogToOF(LogLevel level, const std::string& text){
+    ofLog((ofLogLevel)level, text);
+}
 
 //--------------------------------------------------------------
 void ofApp::setup(){
+    Profiler::SetThreadName("main");
+    AsyncLog::SetSink(&LogToOF);
 
-    ofSetFrameRate(60);
+    ofSetFrameRate(60); // render cap only, the simulation rate is simClock's
     ofSetBackgroundColor(ofColor::blue);
-    backgroundImage.load("background.png");
-    backgroundImage.resize(ofGetWindowWidth(), ofGetWindowHeight());
-    backgroundMusic.load("background.mp3"); // file in bin/data/
-    backgroundMusic.setLoop(true);
-    backgroundMusic.setVolume(0.6f); // 0.0 - 1.0
-    backgroundMusic.play();
 
+    // nothing below waits on a file, the first frame shows the intro with a progress bar
+    // what each scene draws, preloaded in the order the scenes come up
+    const string intro = GameSceneKindToString(GameSceneKind::GAME_INTRO);
+    const string aquarium = GameSceneKindToString(GameSceneKind::AQUARIUM_GAME);
+    const string gameOver = GameSceneKindToString(GameSceneKind::GAME_OVER);
+    SpriteKey background{"background.png", ofGetWindowWidth(), ofGetWindowHeight()};
+    SpriteKey title{"title.png", ofGetWindowWidth(), ofGetWindowHeight()};
+    SpriteKey gameOverBanner{"game-over.png", ofGetWindowWidth(), ofGetWindowHeight()};
+    spriteCache.declare(intro, background);
+    spriteCache.declare(intro, title);
+    spriteCache.declare(aquarium, background);
+    AquariumSpriteManager::DeclareAssets(spriteCache, aquarium);
+    spriteCache.declare(gameOver, gameOverBanner);
+
+    assetLoader = std::make_unique<AssetLoader>(spriteCache);
+    assetLoader->preloadScene(intro);
+    assetLoader->preloadScene(aquarium);
+    assetLoader->preloadScene(gameOver);
+    backgroundImage = assetLoader->requestSprite(background);
+    assetLoader->requestOnMainThread("background.mp3", [this]() {
+        backgroundMusic.load("background.mp3"); // file in bin/data/
+        backgroundMusic.setLoop(true);
+        backgroundMusic.setVolume(0.6f); // 0.0 - 1.0
+        backgroundMusic.play();
+    });
 
-    std::shared_ptr<Aquarium> myAquarium;
-    std::shared_ptr<PlayerCreature> player;
 
     // make the game scene manager 
     gameManager = std::make_unique<GameSceneManager>();
 
 
     // first we make the intro scene 
-    gameManager->AddScene(std::make_shared<GameIntroScene>(
-        GameSceneKindToString(GameSceneKind::GAME_INTRO),
-        std::make_shared<GameSprite>("title.png", ofGetWindowWidth(), ofGetWindowHeight())
-    ));
+    introScene = std::make_shared<GameIntroScene>(intro, assetLoader->requestSprite(title));
+    gameManager->AddScene(introScene);
 
     //AquariumSpriteManager
-    spriteManager = std::make_shared<AquariumSpriteManager>();
-
-    // Lets setup the aquarium
-    myAquarium = std::make_shared<Aquarium>(ofGetWindowWidth(), ofGetWindowHeight(), spriteManager);
-    player = std::make_shared<PlayerCreature>(ofGetWindowWidth()/2 - 50, ofGetWindowHeight()/2 - 50, DEFAULT_SPEED, this->spriteManager->GetSprite(AquariumCreatureType::NPCreature));
-    player->setDirection(0, 0); // Initially stationary
-    player->setBounds(ofGetWindowWidth() - 20, ofGetWindowHeight() - 20);
-
-
-    myAquarium->addAquariumLevel(std::make_shared<Level_0>(0, 10));
-    myAquarium->addAquariumLevel(std::make_shared<Level_1>(1, 15));
-    myAquarium->addAquariumLevel(std::make_shared<Level_2>(2, 20));
-    myAquarium->addAquariumLevel(std::make_shared<Level_3>(3, 25));
-    myAquarium->addAquariumLevel(std::make_shared<Level_4>(4, 30));
-    myAquarium->Repopulate(); // initial population
-    ofLogNotice() << myAquarium->getCreatureCount();
-
-    // now that we are mostly set, lets pass the player and the aquarium downstream
-    gameManager->AddScene(std::make_shared<AquariumGameScene>(
-        std::move(player), std::move(myAquarium), GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)
-    )); // player and aquarium are owned by the scene moving forward
+    spriteManager = std::make_shared<AquariumSpriteManager>(*assetLoader);
+
+    // Lets setup the aquarium, the player and the levels
+    // now that we are mostly set, lets pass the scene downstream
+    // levels come from the compiled pack in bin/data (see --compile-levels), the pack is only
+    // read while the levels are built so it can be closed again right after
+    LevelPack levels;
+    std::string levelsError;
+    if (!levels.open(ofToDataPath("levels.aqlp", true), levelsError)) {
+        ofLogWarning() << "levels.aqlp: " << levelsError << ", using the built-in levels";
+        levels.loadBuiltin(levelsError);
+    }
+    // a fresh seed each launch, the headless runner passes a fixed one to replay a run
+    replaySetup.seed = ofGetSystemTimeMicros();
+    replaySetup.width = ofGetWindowWidth();
+    replaySetup.height = ofGetWindowHeight();
+    replaySetup.playerSpeed = DEFAULT_SPEED;
+    replaySetup.tickHz = (int)SIM_TICK_HZ;
+    replaySetup.checksumInterval = replaySetup.tickHz; // once a second
+    replaySetup.maxTicks = replaySetup.tickHz * 60 * 60;
+    replaySetup.levelsChecksum = ChecksumBytes(levels.getData(), levels.getSize());
+    aquariumScene = CreateAquariumGameScene(
+        replaySetup.width, replaySetup.height, DEFAULT_SPEED, replaySetup.seed, &levels, SIM_TICK_HZ
+    );
+    aquariumRenderer = std::make_shared<AquariumRenderer>(spriteManager);
+    aquariumScene->SetRenderer(aquariumRenderer);
+    gameEvents = aquariumScene->GetEvents().makeReader();
+    recorder.start(*aquariumScene, replaySetup, false);
+    gameManager->AddScene(aquariumScene);
 
     // Load font for game over message
-    gameOverTitle.load("Verdana.ttf", 12, true, true);
-    gameOverTitle.setLineHeight(34.0f);
-    gameOverTitle.setLetterSpacing(1.035);
+    assetLoader->requestOnMainThread("Verdana.ttf", [this]() {
+        gameOverTitle.load("Verdana.ttf", 12, true, true);
+        gameOverTitle.setLineHeight(34.0f);
+        gameOverTitle.setLetterSpacing(1.035);
+    });
+
 
+    gameManager->AddScene(std::make_shared<GameOverScene>(gameOver, assetLoader->requestSprite(gameOverBanner)));
 
-    gameManager->AddScene(std::make_shared<GameOverScene>(
-        GameSceneKindToString(GameSceneKind::GAME_OVER),
-        std::make_shared<GameSprite>("game-over.png", ofGetWindowWidth(), ofGetWindowHeight())
-    ));
+    introScene->SetLoadProgress(assetLoader->getProgress(), "");
 
-    ofSetLogLevel(OF_LOG_VERBOSE); // Set default log level
+    // per-tick messages below AQUARIUM_LOG_MIN_LEVEL are already compiled out, see Log.h;
+    // 'v' switches to verbose while debugging
+    ofSetLogLevel(OF_LOG_NOTICE);
+    AsyncLog::SetLevel(LogLevel::Notice);
 }
 
 //--------------------------------------------------------------
 void ofApp::update(){
-    
+    AQ_PROFILE_SCOPE("ofApp::update");
+    frameStats.beginFrame(ofGetLastFrameTime());
+    uint64_t start = ofGetElapsedTimeMicros();
+    stepGame();
+    frameStats.addUpdateTime((ofGetElapsedTimeMicros() - start) / 1000.0f);
+
+    auto aquarium = aquariumScene->GetAquarium();
+    const AquariumCounters& counters = aquarium->getCounters();
+    frameStats.setSubsystemTotals(aquarium->getCreatureCount(), counters.added, counters.removed,
+                                  counters.collisionTests, counters.collisionPasses);
+}
+
+//--------------------------------------------------------------
+void ofApp::stepGame(){
     ofSoundUpdate(); // Update sound system each frame
+    spriteCache.setActiveScene(gameManager->GetActiveSceneName());
+
+    if (!assetLoader->isDone()) {
+        assetLoader->update();
+        introScene->SetLoadProgress(assetLoader->getProgress(), assetLoader->getCurrentName());
+    }
 
 
     if(gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::GAME_OVER)){
         return; // Stop updating if game is over or exiting
     }
 
-    if(gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)){
-        auto gameScene = std::static_pointer_cast<AquariumGameScene>(gameManager->GetActiveScene());
-        if(gameScene->GetLastEvent() != nullptr && gameScene->GetLastEvent()->isGameOver()){
-            gameManager->Transition(GameSceneKindToString(GameSceneKind::GAME_OVER));
-            return;
+    // run however many fixed ticks the elapsed frame time is worth (possibly none)
+    int steps = simClock.advance(ofGetLastFrameTime());
+    bool inAquarium = gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::AQUARIUM_GAME);
+    for (int i = 0; i < steps; ++i) {
+        gameManager->UpdateActiveScene();
+        if (inAquarium) recorder.noteTick(*aquariumScene);
+
+        GameEvent event;
+        while (gameEvents.poll(event)) {
+            if (event.isGameOver()) {
+                gameManager->Transition(GameSceneKindToString(GameSceneKind::GAME_OVER));
+                return;
+            }
         }
-        
     }
-
-    gameManager->UpdateActiveScene();
     
 
 
@@ -91,7 +152,31 @@ void ofApp::update(){
 
 //--------------------------------------------------------------
 void ofApp::draw(){
-    backgroundImage.draw(0, 0);
+    AQ_PROFILE_SCOPE("ofApp::draw");
+    uint64_t start = ofGetElapsedTimeMicros();
+    drawScenes();
+    frameStats.addDrawTime((ofGetElapsedTimeMicros() - start) / 1000.0f);
+    frameStats.draw(10, 110);
+}
+
+//--------------------------------------------------------------
+void ofApp::drawScenes(){
+    DrawCallCounter::reset();
+    backgroundImage->draw(0, 0, ofGetWindowWidth(), ofGetWindowHeight()); // scaled, the cached sprite stays as loaded
+    if(gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)){
+        auto gameScene = std::static_pointer_cast<AquariumGameScene>(gameManager->GetActiveScene());
+        gameScene->SetInterpolation(simClock.getAlpha());
+        gameManager->DrawActiveScene();
+        if (gameScene->IsDebugOverlayVisible()) {
+            // misses in this scene should stay at 0, every one of them was a decode mid game
+            ofDrawBitmapString("Sprite cache: " + std::to_string(spriteCache.getHits()) + " hits, "
+                               + std::to_string(spriteCache.getMisses()) + " misses, "
+                               + std::to_string(spriteCache.getPreloads()) + " preloaded ("
+                               + std::to_string(spriteCache.getSceneMisses(gameScene->GetName())) + " in game), "
+                               + std::to_string(spriteCache.getBytes() / 1024) + " KB", 10, 80);
+        }
+        return;
+    }
     gameManager->DrawActiveScene();
 }
 
@@ -99,39 +184,108 @@ void ofApp::draw(){
 void ofApp::exit(){
     backgroundMusic.stop();
     backgroundMusic.unload();
+    writeTrace();
+    writeReplay();
+    AsyncLog::Flush();
     
 }
 
+//--------------------------------------------------------------
+void ofApp::writeTrace(){
+    if (Profiler::GetZoneCount() == 0) return; // compiled out or switched off
+    std::string path = ofToDataPath("aquarium-trace.json", true);
+    if (Profiler::WriteChromeTrace(path)) {
+        ofLogNotice() << "Profiler trace written to " << path << " (open in ui.perfetto.dev)";
+    } else {
+        ofLogError() << "Could not write profiler trace to " << path;
+    }
+}
+
+//--------------------------------------------------------------
+void ofApp::writeReplay(){
+    if (recorder.getTickCount() == 0) return; // never got past the intro
+    std::string path = ofToDataPath("last-session.aqrp", true);
+    std::string error;
+    if (recorder.save(path, error)) {
+        ofLogNotice() << "Replay of " << recorder.getTickCount() << " ticks written to " << path;
+    } else {
+        ofLogError() << error;
+    }
+}
+
+//--------------------------------------------------------------
+// arrow keys, ']' and '[' are the only keys that reach the simulation, false for the rest
+static bool KeyToAquariumInput(int key, AquariumInput& input){
+    switch(key){
+        case OF_KEY_UP: input = AquariumInput::Up; return true;
+        case OF_KEY_DOWN: input = AquariumInput::Down; return true;
+        case OF_KEY_LEFT: input = AquariumInput::Left; return true;
+        case OF_KEY_RIGHT: input = AquariumInput::Right; return true;
+        case ']': input = AquariumInput::GrowPopulation; return true;
+        case '[': input = AquariumInput::ResetPopulation; return true;
+        default: return false;
+    }
+}
+
 //--------------------------------------------------------------
 void ofApp::keyPressed(int key){
-    if (lastEvent.isGameExit()) { 
-        ofLogNotice() << "Game has ended. Press ESC to exit." << std::endl;
-        return; // Ignore other keys after game over
+    if (key == 'p') {
+        writeTrace(); // any scene, the last few thousand frames
+        return;
+    }
+    if (key == 'f') {
+        frameStats.toggle(); // frame time percentiles and counters
+        return;
+    }
+    if (key == 'v') {
+        // verbose messages still need a build with AQUARIUM_LOG_MIN_LEVEL=0
+        LogLevel level = AsyncLog::GetLevel() == LogLevel::Verbose ? LogLevel::Notice : LogLevel::Verbose;
+        AsyncLog::SetLevel(level);
+        ofSetLogLevel((ofLogLevel)level);
+        return;
     }
     if(gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)){
         auto gameScene = std::static_pointer_cast<AquariumGameScene>(gameManager->GetActiveScene());
+        AquariumInput input;
+        if (KeyToAquariumInput(key, input)) {
+            // through the scene so the recording sees exactly what the simulation got
+            gameScene->ApplyInput(input, true);
+            recorder.recordInput(input, true);
+            return;
+        }
         switch(key){
-            case OF_KEY_UP:
-                gameScene->GetPlayer()->setDirection(gameScene->GetPlayer()->isXDirectionActive()?gameScene->GetPlayer()->getDx():0, -1);
+            case 'd':
+                gameScene->ToggleDebugOverlay(); // draw calls and batching info
+                break;
+            case 'b':
+                aquariumRenderer->setBatchedDrawing(!aquariumRenderer->isBatchedDrawing());
+                break;
+            case 'm':
+                GameSprite::SetUseMirrorCache(!GameSprite::GetUseMirrorCache()); // compare flipped draw paths
                 break;
-                case OF_KEY_DOWN:
-                gameScene->GetPlayer()->setDirection(gameScene->GetPlayer()->isXDirectionActive()?gameScene->GetPlayer()->getDx():0, 1);
+            case 'k':
+                gameScene->SaveSnapshot(quickSave);
+                ofLogNotice() << "quick save: " << quickSave.size() << " bytes";
                 break;
-            case OF_KEY_LEFT:
-                gameScene->GetPlayer()->setDirection(-1, gameScene->GetPlayer()->isYDirectionActive()?gameScene->GetPlayer()->getDy():0);
-                gameScene->GetPlayer()->setFlipped(true);
+            case 'l': {
+                std::string error;
+                if (quickSave.empty()) break;
+                if (!gameScene->RestoreSnapshot(quickSave.data(), quickSave.size(), error)) {
+                    ofLogWarning() << "quick load: " << error;
+                    break;
+                }
+                // the recording so far doesn't lead here anymore, start a new one from the save
+                replaySetup.width = gameScene->GetAquarium()->getWidth();
+                replaySetup.height = gameScene->GetAquarium()->getHeight();
+                recorder.start(*gameScene, replaySetup, true);
                 break;
-                case OF_KEY_RIGHT:
-                gameScene->GetPlayer()->setDirection(1, gameScene->GetPlayer()->isYDirectionActive()?gameScene->GetPlayer()->getDy():0);
-                gameScene->GetPlayer()->setFlipped(false);
+            }
+            case 'r':
+                writeReplay(); // keeps recording
                 break;
             default:
                 break;
         }
-    
-        
-    
-        gameScene->GetPlayer()->move();
         return;
 
     }
@@ -140,6 +294,7 @@ void ofApp::keyPressed(int key){
         switch (key)
         {
         case OF_KEY_SPACE:
+            if (introScene->IsLoading()) break; // sprites aren't all there yet
             gameManager->Transition(GameSceneKindToString(GameSceneKind::AQUARIUM_GAME));
             break;
         
@@ -157,18 +312,12 @@ void ofApp::keyPressed(int key){
 void ofApp::keyReleased(int key){
     if(gameManager->GetActiveSceneName() == GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)){
         auto gameScene = std::static_pointer_cast<AquariumGameScene>(gameManager->GetActiveScene());
-    if( key == OF_KEY_UP || key == OF_KEY_DOWN){
-        gameScene->GetPlayer()->setDirection(gameScene->GetPlayer()->isXDirectionActive()?gameScene->GetPlayer()->getDx():0, 0);
-        gameScene->GetPlayer()->move();
-        return;
-    }
-    
-    if(key == OF_KEY_LEFT || key == OF_KEY_RIGHT){
-        gameScene->GetPlayer()->setDirection(0, gameScene->GetPlayer()->isYDirectionActive()?gameScene->GetPlayer()->getDy():0);
-        gameScene->GetPlayer()->move();
-        return;
-    }
-
+        AquariumInput input;
+        // only the arrows steer, the population keys act on the press alone
+        if (KeyToAquariumInput(key, input) && input <= AquariumInput::Right) {
+            gameScene->ApplyInput(input, false);
+            recorder.recordInput(input, false);
+        }
     }
 }
 
@@ -209,10 +358,9 @@ void ofApp::mouseExited(int x, int y){
 
 //--------------------------------------------------------------
 void ofApp::windowResized(int w, int h){
-    backgroundImage.resize(w, h);
     auto aquariumScene = std::static_pointer_cast<AquariumGameScene>(gameManager->GetScene(GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)));
-    aquariumScene->GetAquarium()->setBounds(w,h);
-    aquariumScene->GetPlayer()->setBounds(w - 20, h - 20);
+    aquariumScene->Resize(w, h);
+    recorder.recordResize(w, h);
 
 }
 
@@ -2,6 +2,10 @@
 
 #include "ofMain.h"
 #include "Aquarium.h"
+#include "AquariumRender.h"
+#include "AssetLoader.h"
+#include "FrameStats.h"
+#include "Replay.h"
 
 
 class ofApp : public ofBaseApp{
@@ -24,6 +28,10 @@ class ofApp : public ofBaseApp{
 		void windowResized(int w, int h) override;
 		void dragEvent(ofDragInfo dragInfo) override;
 		void gotMessage(ofMessage msg) override;
+		void writeTrace(); // profiler zones as a Chrome trace in bin/data, 'p' or on exit
+		void writeReplay(); // the session so far as bin/data/last-session.aqrp, 'r' or on exit
+		void stepGame();   // update() minus the bookkeeping for the stats overlay
+		void drawScenes();
 		ofSoundPlayer backgroundMusic;
 	
 		
@@ -31,15 +39,32 @@ class ofApp : public ofBaseApp{
 		int DEFAULT_SPEED = 5;
 
 
-		AwaitFrames acuariumUpdate{5};
+		// the game simulates at a fixed rate no matter how fast frames are drawn; the aquarium
+		// scales movement and timers to it (see AquariumPace), so fish keep their speed at any rate
+		double SIM_TICK_HZ = 60.0;
+		int MAX_CATCH_UP_STEPS = 5; // ticks per frame before we give up catching up
+		FixedTimestep simClock{SIM_TICK_HZ, MAX_CATCH_UP_STEPS};
 
 		ofTrueTypeFont gameOverTitle;
-		GameEvent lastEvent;
+		GameEventBus::Reader gameEvents; // drained after every simulation tick
+		FrameStats frameStats;
 
 
-		ofImage backgroundImage;
+		// every sprite comes out of the cache, decoded off the main thread by the loader
+		// while the intro scene shows its progress
+		SpriteCache spriteCache;
+		std::unique_ptr<AssetLoader> assetLoader;
+		std::shared_ptr<GameIntroScene> introScene;
+		std::shared_ptr<GameSprite> backgroundImage;
 
 		std::unique_ptr<GameSceneManager> gameManager;
+		std::shared_ptr<AquariumGameScene> aquariumScene;
+		std::vector<uint8_t> quickSave; // 'k' snapshots the aquarium scene, 'l' puts it back
+		// every session is recorded and written to bin/data/last-session.aqrp on exit or 'r',
+		// play it back with --headless --replay; a quick load starts the recording over
+		ReplayRecorder recorder;
+		ReplaySetup replaySetup;
 		std::shared_ptr<AquariumSpriteManager>spriteManager;
+		std::shared_ptr<AquariumRenderer> aquariumRenderer; // the scene itself only simulates
 		
 };
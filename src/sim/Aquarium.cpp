@@ -0,0 +1,998 @@
+#include "Aquarium.h"
+#include "Kinematics.h"
+#include "LevelPack.h"
+#include "Profiler.h"
+#include "Log.h"
+#include <chrono>
+
+
+std::string AquariumCreatureTypeToString(AquariumCreatureType t){
+    switch(t){
+        case AquariumCreatureType::BiggerFish:
+            return "BiggerFish";
+        case AquariumCreatureType::NPCreature:
+            return "BaseFish";
+        case AquariumCreatureType::PinkFish:
+            return "PinkFish";
+        case AquariumCreatureType::SharkFish:
+            return "SharkFish";
+        default:
+            return "UknownFish";
+    }
+}
+
+//Power Up Implementation
+PowerUp::PowerUp(float x, float y, float r, SpriteId sprite)
+    : m_x(x), m_y(y), m_radius(r), m_sprite(sprite) {}
+
+float PowerUp::getX() const { return m_x; }
+float PowerUp::getY() const { return m_y; }
+float PowerUp::getRadius() const { return m_radius; }
+
+// PlayerCreature Implementation
+PlayerCreature::PlayerCreature(float x, float y, int speed, SpriteId sprite)
+: Creature(x, y, speed, 10.0f, 1, sprite) {}
+
+
+void PlayerCreature::setDirection(float dx, float dy) {
+    m_dx = dx;
+    m_dy = dy;
+    normalize();
+}
+
+void PlayerCreature::move() {
+    m_x += m_dx * m_speed * m_tickScale;
+    m_y += m_dy * m_speed * m_tickScale;
+    this->bounce();
+}
+
+void PlayerCreature::reduceDamageDebounce() {
+    if (m_damage_debounce > 0) {
+        --m_damage_debounce;
+    }
+}
+
+void PlayerCreature::update() {
+    this->savePreviousPosition();
+    this->reduceDamageDebounce();
+    this->move();
+}
+
+
+void PlayerCreature::changeSpeed(int speed) {
+    m_speed = speed;
+}
+
+void PlayerCreature::loseLife(int debounce) {
+    if (m_damage_debounce <= 0) {
+        if (m_lives > 0) this->m_lives -= 1;
+        m_damage_debounce = debounce; // Set debounce frames
+        AQ_LOG_NOTICE("Player lost a life! Lives remaining: {}", m_lives);
+    }
+    // If in debounce period, do nothing
+    if (m_damage_debounce > 0) {
+        AQ_LOG_VERBOSE("Player is in damage debounce period. Frames left: {}", m_damage_debounce);
+    }
+}
+
+//growth func
+void PlayerCreature::setPermanentSize(float scaleUp) {
+    m_visualScale = scaleUp;
+
+    setCollisionRadius(getCollisionRadius() * scaleUp);
+}
+
+// NPCreature Implementation
+NPCreature::NPCreature(float x, float y, int speed, SpriteId sprite, RandomStream rng, const AquariumPace& pace)
+: Creature(x, y, speed, 30, 1, sprite), m_rng(rng), m_pace(pace) {
+    m_dx = (m_rng.nextInt(3) - 1); // -1, 0, or 1
+    m_dy = (m_rng.nextInt(3) - 1); // -1, 0, or 1
+    normalize();
+
+    m_creatureType = AquariumCreatureType::NPCreature;
+}
+
+// distance per tick, the same float math as the array storage update so both stay identical
+static float StepSpeed(int speed, const AquariumPace& pace) { return (float)speed * pace.stepScale; }
+
+void NPCreature::move() {
+    // Simple AI movement logic (random direction)
+    float speed = StepSpeed(m_speed, m_pace);
+    m_x += m_dx * speed;
+    m_y += m_dy * speed;
+    // set per-creature flipped flag instead of mutating shared sprite
+    this->setFlipped(m_dx < 0);
+    bounce();
+}
+
+
+BiggerFish::BiggerFish(float x, float y, int speed, SpriteId sprite, RandomStream rng, const AquariumPace& pace)
+: NPCreature(x, y, speed, sprite, rng, pace) {
+    m_dx = (m_rng.nextInt(3) - 1);
+    m_dy = (m_rng.nextInt(3) - 1);
+    normalize();
+
+    setCollisionRadius(60); // Bigger fish have a larger collision radius
+    m_value = 5; // Bigger fish have a higher value
+    m_creatureType = AquariumCreatureType::BiggerFish;
+}
+
+void BiggerFish::move() {
+    // Bigger fish might move slower or have different logic
+    float speed = StepSpeed(m_speed, m_pace);
+    m_x += m_dx * (speed * 0.5f); // Moves at half speed
+    m_y += m_dy * (speed * 0.5f);
+    this->setFlipped(m_dx < 0);
+
+    bounce();
+}
+
+
+PinkFish::PinkFish(float x, float y, int speed, SpriteId sprite, RandomStream rng, const AquariumPace& pace)
+: NPCreature(x, y, speed, sprite, rng, pace) {
+    m_dx = 1;
+    m_dy = 0;
+    normalize();
+
+    setCollisionRadius(30);
+    m_value = 2;
+    m_creatureType = AquariumCreatureType::PinkFish;
+}  
+
+// Use a precalculated sine table to avoid expensive sin calculations
+// shared by PinkFish::move and the array storage update
+static const int SINE_TABLE_SIZE = 256;
+static const float TWO_PI = 6.28318530717958647692f;
+
+struct SineTable {
+    float values[SINE_TABLE_SIZE];
+    SineTable() {
+        for (int i = 0; i < SINE_TABLE_SIZE; i++) {
+            values[i] = sinf((float)i * TWO_PI / SINE_TABLE_SIZE);
+        }
+    }
+};
+
+static float PinkFishWave(float t) {
+    // Initialize sine table once, as a function static so parallel updates can share it safely
+    static const SineTable table;
+
+    // Look up sine value
+    int index = (int)(t * SINE_TABLE_SIZE / TWO_PI) % SINE_TABLE_SIZE;
+    return table.values[index] * 2.0f; // amplitude = 2.0f
+}
+
+static float PinkFishAdvancePhase(float t, const AquariumPace& pace) {
+    // Increment and wrap time
+    t += 0.05f * pace.stepScale;
+    if (t >= TWO_PI) t -= TWO_PI;
+    return t;
+}
+
+void PinkFish::move(){
+    t = PinkFishAdvancePhase(t, m_pace);
+    float sinY = PinkFishWave(t);
+    float speed = StepSpeed(m_speed, m_pace);
+    
+    m_x += m_dx * speed;
+    m_y += (m_dy + sinY) * 0.5f * speed;
+    
+    this->setFlipped(m_dx < 0);
+    
+    bounce();
+}
+
+
+SharkFish::SharkFish(float x, float y, int speed, SpriteId sprite, RandomStream rng, const AquariumPace& pace)
+: NPCreature(x, y, speed, sprite, rng, pace) {
+
+    m_dx = (m_rng.nextInt(2) == 0) ? 1 : -1;
+    m_dy = 0;
+    normalize();
+
+    setCollisionRadius(45);               
+    m_value = 10;                         
+    m_creatureType = AquariumCreatureType::SharkFish;
+
+    dashFrames = 0;
+    cooldownFrames = m_pace.ticks((60 + m_rng.nextInt(120)) * kAquariumTicksPerStep);
+}
+
+// the dash timers count ticks, the dash chance and the drift are per tick too, all scaled by
+// the pace so a shark behaves over time the way it did when it moved once every
+// kAquariumTicksPerStep ticks at the design rate
+static int SharkDashTicks(const AquariumPace& pace) { return pace.ticks(18 * kAquariumTicksPerStep); }
+static int SharkDashChanceOutOf(const AquariumPace& pace) { return pace.ticks(100 * kAquariumTicksPerStep); } // 12 in this
+static int SharkCooldownTicks(const AquariumPace& pace, RandomStream& rng) {
+    return pace.ticks((90 + rng.nextInt(120)) * kAquariumTicksPerStep);
+}
+// the drift is a random walk, which spreads with the square root of the ticks it runs for,
+// so it scales by the root of the step scale to spread as far per tuned step as it used to
+static float SharkDrift(const AquariumPace& pace) { return 0.02f * std::sqrt(pace.stepScale); }
+
+void SharkFish::move() {
+    this->setFlipped(m_dx < 0);
+
+    float speedMul = 1.4f;     
+    if (dashFrames > 0) {
+        speedMul = 2.6f;       
+        dashFrames--;
+    } else {
+        //count down till next dash
+        if (cooldownFrames > 0) cooldownFrames--;
+        else {
+           //rand dash
+            if (m_rng.nextInt(SharkDashChanceOutOf(m_pace)) < 12) {
+                dashFrames = SharkDashTicks(m_pace);
+                cooldownFrames = SharkCooldownTicks(m_pace, m_rng);
+            }
+        }
+        
+        m_dy += (m_rng.nextInt(3) - 1) * SharkDrift(m_pace);
+        if (m_dy >  0.6f) m_dy =  0.6f;
+        if (m_dy < -0.6f) m_dy = -0.6f;
+        normalize();
+    }
+
+    float speed = StepSpeed(m_speed, m_pace);
+    m_x += m_dx * (speed * speedMul);
+    m_y += m_dy * (speed * speedMul);
+
+    bounce(); 
+}
+
+
+// Aquarium Implementation
+Aquarium::Aquarium(int width, int height)
+    : m_width(width), m_height(height) {
+        m_store.setBounds(width - 20, height - 20);
+        for (auto& pool : m_pools) {
+            pool = std::make_shared<BlockPool>();
+        }
+    }
+
+
+
+void Aquarium::addCreature(std::shared_ptr<Creature> creature) {
+    this->insertCreature(creature);
+    if (m_events) m_events->publish(GameEvent(GameEventType::CREATURE_ADDED, creature->getHandle(), CreatureHandle()));
+}
+
+void Aquarium::insertCreature(std::shared_ptr<Creature> creature) {
+    creature->setBounds(m_width - 20, m_height - 20);
+    m_maxCollisionRadius = std::max(m_maxCollisionRadius, creature->getCollisionRadius());
+    auto npc = std::static_pointer_cast<NPCreature>(creature);
+    if (m_storage == CreatureStorage::Arrays) {
+        m_store.attach(creature.get(), (int)npc->GetType());
+    }
+    m_groups.add((int)npc->GetType(), creature.get());
+    int index = (int)m_creatures.size();
+    creature->setAquariumIndex(index);
+    m_registry.add(creature.get());
+    m_creatures.push_back(creature);
+    m_gridPoints.push_back({creature->getX(), creature->getY(), creature->getCollisionRadius()});
+    // a bigger radius needs bigger cells, anything else goes straight into its cell
+    if (!m_gridDirty && m_grid.getCellSize() != this->spatialCellSize()) m_gridDirty = true;
+    if (!m_gridDirty) m_grid.insert(index, m_gridPoints[index].x, m_gridPoints[index].y);
+    m_counters.added++;
+}
+
+// the walls move for everyone already swimming too, not just for the next spawns
+void Aquarium::setBounds(int w, int h) {
+    m_width = w;
+    m_height = h;
+    m_store.setBounds(w - 20, h - 20);
+    for (auto& creature : m_creatures) creature->setBounds(w - 20, h - 20);
+    m_gridDirty = true;
+}
+
+void Aquarium::addAquariumLevel(std::shared_ptr<AquariumLevel> level){
+    if(level == nullptr){return;} // guard to not add noise
+    this->m_aquariumlevels.push_back(level);
+    m_repopulatePending = true;
+}
+
+void Aquarium::setStorage(CreatureStorage storage) {
+    if (storage == m_storage) return;
+    m_storage = storage;
+    if (storage == CreatureStorage::Arrays) {
+        m_store.setBounds(m_width - 20, m_height - 20);
+        for (auto& creature : m_creatures) {
+            auto npc = std::static_pointer_cast<NPCreature>(creature);
+            m_store.attach(creature.get(), (int)npc->GetType());
+        }
+    } else {
+        m_store.clear(); // hands the state back to the objects
+    }
+}
+
+void Aquarium::setThreadCount(int threads) {
+    threads = std::max(threads, 1);
+    if (threads == this->getThreadCount()) return;
+    m_workers = threads > 1 ? std::make_unique<WorkerPool>(threads) : nullptr;
+}
+
+int Aquarium::getThreadCount() const {
+    return m_workers ? m_workers->getThreadCount() : 1;
+}
+
+void Aquarium::setTickRate(double tickHz) {
+    m_pace = AquariumPace::ForTickRate(tickHz);
+    m_groups.forEachGroup([this](int, auto& group) {
+        for (auto* creature : group) creature->setPace(m_pace);
+    });
+}
+
+void Aquarium::scaleLevelPopulations(int factor) {
+    for (auto& level : m_aquariumlevels) {
+        level->scalePopulation(factor);
+    }
+    m_repopulatePending = true;
+}
+
+void Aquarium::resetLevelPopulations() {
+    for (auto& level : m_aquariumlevels) {
+        level->resetPopulationScale();
+    }
+}
+
+// Movement is the only parallel phase: every creature only touches its own state and its
+// own random stream, so chunks can run in any order with the same result. Everything that
+// changes shared state (spawns, removals, level score, the grid) happens afterwards on
+// this thread in a fixed order, which keeps multithreaded runs identical to single threaded ones.
+void Aquarium::update() {
+    AQ_PROFILE_SCOPE("Aquarium::update");
+    if (m_storage == CreatureStorage::Arrays) {
+        this->forEachChunk(m_store.size(), [this](int begin, int end) { this->updateArrays(begin, end); });
+    } else {
+        // one tight loop per type, every call below is resolved at compile time
+        m_groups.forEachGroup([this](int, auto& group) {
+            this->forEachChunk((int)group.size(), [this, &group](int begin, int end) {
+                thread_local std::vector<GridMove> moves;
+                moves.clear();
+                for (int i = begin; i < end; ++i) {
+                    auto* creature = group[i];
+                    creature->savePreviousPosition();
+                    MoveExact(creature);
+                    this->trackGridPosition(creature->getAquariumIndex(), creature->getX(), creature->getY(), moves);
+                }
+                this->queueGridMoves(moves);
+            });
+        });
+    }
+    this->applyGridMoves(); // only the creatures that crossed into another cell
+    if (m_repopulatePending) this->Repopulate();
+}
+
+void Aquarium::queueGridMoves(const std::vector<GridMove>& moves) {
+    if (moves.empty()) return;
+    std::lock_guard<std::mutex> lock(m_gridMovesLock);
+    m_gridMoves.insert(m_gridMoves.end(), moves.begin(), moves.end());
+}
+
+void Aquarium::applyGridMoves() {
+    AQ_PROFILE_SCOPE("Aquarium grid moves");
+    // chunks finish in any order, sorted the cells come out the same on any thread count
+    std::sort(m_gridMoves.begin(), m_gridMoves.end(), [](const GridMove& a, const GridMove& b) { return a.id < b.id; });
+    for (const GridMove& move : m_gridMoves) m_grid.moveTo(move.id, move.cell);
+    m_counters.gridCellMoves += m_gridMoves.size();
+    m_gridMoves.clear();
+}
+
+void Aquarium::forEachChunk(int count, const std::function<void(int, int)>& fn) {
+    if (!m_workers) {
+        fn(0, count);
+        return;
+    }
+    // one zone per chunk so each worker's share shows up on its own track
+    m_workers->parallelFor(count, [&fn](int begin, int end) {
+        AQ_PROFILE_SCOPE("Aquarium::update chunk");
+        fn(begin, end);
+    });
+}
+
+// mirrors the per-type move() logic over the CreatureStore arrays for slots [begin, end)
+void Aquarium::updateArrays(int begin, int end) {
+    CreatureStore& s = m_store;
+    const AquariumPace& pace = m_pace;
+
+    std::copy(s.x.begin() + begin, s.x.begin() + end, s.prevX.begin() + begin);
+    std::copy(s.y.begin() + begin, s.y.begin() + end, s.prevY.begin() + begin);
+
+    // behaviour pass: per-type speed terms plus the pink wave and shark dash state
+    for (int i = begin; i < end; ++i) {
+        float speed = StepSpeed(s.speed[i], pace);
+        switch ((AquariumCreatureType)s.type[i]) {
+            case AquariumCreatureType::BiggerFish:
+                s.sx[i] = s.sy[i] = speed * 0.5f; // Moves at half speed
+                s.oy[i] = 0.0f;
+                break;
+            case AquariumCreatureType::PinkFish: {
+                s.phase[i] = PinkFishAdvancePhase(s.phase[i], pace);
+                s.sx[i] = speed;
+                s.sy[i] = 0.5f * speed;
+                s.oy[i] = PinkFishWave(s.phase[i]) * 0.5f * speed;
+                break;
+            }
+            case AquariumCreatureType::SharkFish: {
+                float speedMul = 1.4f;
+                if (s.dashFrames[i] > 0) {
+                    speedMul = 2.6f;
+                    s.dashFrames[i]--;
+                } else {
+                    if (s.cooldownFrames[i] > 0) s.cooldownFrames[i]--;
+                    else if (s.rng[i].nextInt(SharkDashChanceOutOf(pace)) < 12) {
+                        s.dashFrames[i] = SharkDashTicks(pace);
+                        s.cooldownFrames[i] = SharkCooldownTicks(pace, s.rng[i]);
+                    }
+                    float dy = s.dy[i] + (s.rng[i].nextInt(3) - 1) * SharkDrift(pace);
+                    dy = std::clamp(dy, -0.6f, 0.6f);
+                    float len = std::sqrt(s.dx[i] * s.dx[i] + dy * dy);
+                    if (len != 0) {
+                        s.dx[i] /= len;
+                        dy /= len;
+                    }
+                    s.dy[i] = dy;
+                }
+                s.sx[i] = s.sy[i] = speed * speedMul;
+                s.oy[i] = 0.0f;
+                break;
+            }
+            default:
+                s.sx[i] = s.sy[i] = speed;
+                s.oy[i] = 0.0f;
+                break;
+        }
+    }
+
+    // kinematics pass: integrate, flip and bounce off the aquarium walls (vectorized when available)
+    KinematicsBatch batch{s.x.data() + begin, s.y.data() + begin, s.dx.data() + begin, s.dy.data() + begin,
+                          s.sx.data() + begin, s.sy.data() + begin, s.oy.data() + begin, s.flipped.data() + begin,
+                          end - begin, s.boundsW, s.boundsH};
+    IntegrateCreatures(batch);
+
+    // slots are in aquarium order, so the slot is the creature's index
+    thread_local std::vector<GridMove> moves;
+    moves.clear();
+    for (int i = begin; i < end; ++i) this->trackGridPosition(i, s.x[i], s.y[i], moves);
+    this->queueGridMoves(moves);
+}
+
+// O(1): the creature knows its index, the last creature is moved into the hole
+void Aquarium::removeCreature(CreatureHandle handle) {
+    Creature* resolved = m_registry.resolve(handle);
+    int index = resolved ? resolved->getAquariumIndex() : -1;
+    if (index < 0 || size_t(index) >= m_creatures.size() || m_creatures[index].get() != resolved) {
+        return; // stale handle, or not one of our creatures (the player)
+    }
+    std::shared_ptr<Creature> creature = m_creatures[index]; // keep it alive until we are done
+    AQ_LOG_VERBOSE("removing creature");
+    int selectLvl = this->currentLevel % this->m_aquariumlevels.size();
+    auto npcCreature = std::static_pointer_cast<NPCreature>(creature);
+    this->m_aquariumlevels.at(selectLvl)->ConsumePopulation(npcCreature->GetType(), npcCreature->getValue());
+    m_store.detach(creature.get());
+    m_groups.remove((int)npcCreature->GetType(), creature.get());
+
+    if (size_t(index) != m_creatures.size() - 1) {
+        m_creatures[index] = std::move(m_creatures.back());
+        m_creatures[index]->setAquariumIndex(index);
+    }
+    m_creatures.pop_back();
+    creature->setAquariumIndex(-1);
+    m_registry.remove(handle);
+    // the index follows the creature that filled the hole
+    if (!m_gridDirty) m_grid.removeSwapLast(index);
+    m_gridPoints[index] = m_gridPoints.back();
+    m_gridPoints.pop_back();
+    m_repopulatePending = true; // a gap to fill, and maybe the level is done
+    m_counters.removed++;
+    // the handle is already stale here, readers only get to compare it
+    if (m_events) m_events->publish(GameEvent(GameEventType::CREATURE_REMOVED, handle, CreatureHandle()));
+}
+
+void Aquarium::clearCreatures() {
+    m_counters.removed += m_creatures.size();
+    m_store.clear();
+    m_groups.clear();
+    for (auto& creature : m_creatures) {
+        creature->setAquariumIndex(-1);
+        m_registry.remove(creature->getHandle()); // outstanding handles go stale
+    }
+    m_creatures.clear(); // keeps its capacity, and the blocks go back to the pools
+    m_grid.clear();
+    m_gridPoints.clear();
+    m_maxCollisionRadius = 0.0f; // the next level's fish may all be small, the first spawn resizes the cells
+}
+
+std::shared_ptr<Creature> Aquarium::getCreatureAt(int index) {
+    if (index < 0 || size_t(index) >= m_creatures.size()) {
+        return nullptr;
+    }
+    return m_creatures[index];
+}
+
+CreatureHandle Aquarium::getCreatureHandleAt(int index) const {
+    if (index < 0 || size_t(index) >= m_creatures.size()) {
+        return CreatureHandle();
+    }
+    return m_creatures[index]->getHandle();
+}
+
+// rare (first use, resizes, bigger cells, restores), so it reads every creature again rather
+// than trusting the positions to have been kept up while the grid was out of date
+void Aquarium::refreshSpatialIndex() {
+    if (!m_gridDirty) return;
+    AQ_PROFILE_SCOPE("Aquarium grid rebuild");
+    // spawns only ever raise the largest radius, removals leave it; the rebuild reads every
+    // radius anyway, so it puts it back to what is really there and the cells shrink with it
+    int n = (int)m_creatures.size();
+    m_maxCollisionRadius = 0.0f;
+    for (int i = 0; i < n; ++i) {
+        m_gridPoints[i] = {m_creatures[i]->getX(), m_creatures[i]->getY(), m_creatures[i]->getCollisionRadius()};
+        m_maxCollisionRadius = std::max(m_maxCollisionRadius, m_gridPoints[i].r);
+    }
+    // cells twice the largest radius means a touching pair is never more than one cell apart
+    float cellSize = this->spatialCellSize();
+    if (cellSize != m_grid.getCellSize() || m_grid.getCols() * cellSize < m_width || m_grid.getRows() * cellSize < m_height) {
+        m_grid.configure(m_width, m_height, cellSize);
+    }
+    if (n > 0) m_grid.build(&m_gridPoints[0].x, &m_gridPoints[0].y, n, sizeof(GridPoint) / sizeof(float));
+    else m_grid.clear();
+    m_gridDirty = false;
+    m_counters.gridRebuilds++;
+}
+
+int Aquarium::queryRadius(float x, float y, float radius, std::vector<int>& out) {
+    out.clear();
+    this->refreshSpatialIndex();
+    float reach = radius + m_maxCollisionRadius;
+    m_grid.forEachInRect(x - reach, y - reach, x + reach, y + reach, [&](int i) {
+        const GridPoint& p = m_gridPoints[i];
+        float dx = p.x - x;
+        float dy = p.y - y;
+        float r = radius + p.r;
+        if (dx * dx + dy * dy <= r * r) out.push_back(i);
+    });
+    return (int)out.size();
+}
+
+int Aquarium::queryAABB(float minX, float minY, float maxX, float maxY, std::vector<int>& out) {
+    out.clear();
+    this->refreshSpatialIndex();
+    m_grid.forEachInRect(minX, minY, maxX, maxY, [&](int i) {
+        const GridPoint& p = m_gridPoints[i];
+        if (p.x >= minX && p.x <= maxX && p.y >= minY && p.y <= maxY) {
+            out.push_back(i);
+        }
+    });
+    return (int)out.size();
+}
+
+
+
+// object and control block come from the type's pool, no heap allocation once it has warmed up
+template <typename T>
+static std::shared_ptr<T> MakePooledCreature(const std::shared_ptr<BlockPool>& pool, int x, int y, int speed,
+                                             SpriteId sprite, RandomStream rng, const AquariumPace& pace) {
+    return std::allocate_shared<T>(PoolAllocator<T>(pool), x, y, speed, sprite, rng, pace);
+}
+
+void Aquarium::SpawnCreatures(AquariumCreatureType type, int count) {
+    if (count <= 0) return;
+    // the same for the whole batch
+    std::shared_ptr<AquariumLevel> level = this->getActiveLevel();
+    int minSpeed = level ? level->getMinSpeed() : 1;
+    int maxSpeed = level ? level->getMaxSpeed() : 25;
+
+    for (int n = 0; n < count; ++n) {
+        int x = m_rng.nextInt(this->getWidth());
+        int y = m_rng.nextInt(this->getHeight());
+        int speed = minSpeed + m_rng.nextInt(maxSpeed - minSpeed + 1);
+        RandomStream rng = RandomStream::Substream(m_seed, m_spawnCount++);
+
+        std::shared_ptr<Creature> creature = this->makeCreature(type, x, y, speed, rng);
+        if (!creature) {
+            AQ_LOG_ERROR("Unknown creature type to spawn!");
+            return;
+        }
+        this->insertCreature(std::move(creature));
+    }
+    if (m_events) {
+        GameEvent spawned(GameEventType::CREATURES_SPAWNED, CreatureHandle(), CreatureHandle());
+        spawned.creatureType = (int)type;
+        spawned.count = count;
+        m_events->publish(spawned);
+    }
+}
+
+std::shared_ptr<Creature> Aquarium::makeCreature(AquariumCreatureType type, int x, int y, int speed, RandomStream rng) {
+    const std::shared_ptr<BlockPool>& pool = m_pools[(int)type];
+    SpriteId sprite = AquariumCreatureSprite(type);
+    switch (type) {
+        case AquariumCreatureType::NPCreature:
+            return MakePooledCreature<NPCreature>(pool, x, y, speed, sprite, rng, m_pace);
+        case AquariumCreatureType::BiggerFish:
+            return MakePooledCreature<BiggerFish>(pool, x, y, speed, sprite, rng, m_pace);
+        case AquariumCreatureType::PinkFish:
+            return MakePooledCreature<PinkFish>(pool, x, y, speed, sprite, rng, m_pace);
+        case AquariumCreatureType::SharkFish:
+            return MakePooledCreature<SharkFish>(pool, x, y, speed, sprite, rng, m_pace);
+        // no default, so -Wswitch points here when a type is added
+    }
+    return nullptr;
+}
+
+
+// repopulation will be called from the levl class
+// it will compose into aquarium so eating eats frm the pool of NPCs in the lvl class
+// once lvl criteria met, we move to new lvl through inner signal asking for new lvl
+// which will mean incrementing the buffer and pointing to a new lvl index
+void Aquarium::Repopulate() {
+    AQ_PROFILE_SCOPE("Aquarium::Repopulate");
+    AQ_LOG_VERBOSE("entering phase repopulation");
+    m_repopulatePending = false;
+    // lets make the levels circular
+    int selectedLevelIdx = this->currentLevel % this->m_aquariumlevels.size();
+    AQ_LOG_VERBOSE("the current index: {}", selectedLevelIdx);
+    std::shared_ptr<AquariumLevel> level = this->m_aquariumlevels.at(selectedLevelIdx);
+
+
+    if (level->isCompleted()){
+        level->levelReset();
+        this->currentLevel += 1;
+        
+        selectedLevelIdx = this->currentLevel % this->m_aquariumlevels.size();
+        AQ_LOG_NOTICE("Level Up! Now entering level {}", this->currentLevel);
+        this->clearCreatures();
+        if (m_events) m_events->publish(GameEvent(GameEventType::NEW_LEVEL, CreatureHandle(), CreatureHandle()));
+        level = this->m_aquariumlevels.at(selectedLevelIdx);
+    }
+
+    if(!level){
+        AQ_LOG_ERROR("Error: Level is null during repopulation!");
+        return;
+    }
+
+    AQ_LOG_VERBOSE("Calling level ->Repopulate()");
+    // now lets find how many to respawn if needed (call once)
+    level->Repopulate(*this, m_spawnBatches);
+    AQ_LOG_VERBOSE("types to repopulate : {}", m_spawnBatches.size());
+    // room for the whole refill up front, the batches then spawn without growing anything
+    int refill = 0;
+    for(const AquariumSpawnBatch& batch : m_spawnBatches){
+        refill += batch.count;
+        m_groups.reserve((int)batch.type, m_groups.size((int)batch.type) + batch.count);
+    }
+    if (refill > 0) {
+        int total = (int)m_creatures.size() + refill;
+        m_creatures.reserve(total);
+        m_registry.reserve(refill);
+        if (m_storage == CreatureStorage::Arrays) m_store.reserve(total);
+    }
+    for(const AquariumSpawnBatch& batch : m_spawnBatches){
+        this->SpawnCreatures(batch.type, batch.count);
+    }
+}
+
+
+// Aquarium collision detection, the spatial index hands back only the creatures near the player
+int DetectAquariumCollisions(std::shared_ptr<Aquarium> aquarium, std::shared_ptr<PlayerCreature> player, std::vector<CreatureHandle>& out) {
+    AQ_PROFILE_SCOPE("DetectAquariumCollisions");
+    out.clear();
+    if (!aquarium || !player) return 0;
+    
+    // Player position and radius
+    float px = player->getX();
+    float py = player->getY();
+    float pr = player->getCollisionRadius();
+    float maxCheckDistance = pr * 4; // Only check creatures within this range
+    float maxDistSq = maxCheckDistance * maxCheckDistance;
+
+    struct Contact { float distSq; int index; };
+    thread_local std::vector<int> candidates; // reused between ticks to avoid allocating
+    thread_local std::vector<Contact> contacts;
+    aquarium->queryRadius(px, py, pr, candidates);
+    aquarium->noteCollisionTests((int)candidates.size());
+    contacts.clear();
+    
+    for (int i : candidates) {
+        Creature* creature = aquarium->resolve(aquarium->getCreatureHandleAt(i));
+        if (!creature) continue;
+        
+        float dx = creature->getX() - px;
+        float dy = creature->getY() - py;
+        float distSq = dx * dx + dy * dy;
+        if (distSq > maxDistSq) continue;
+        contacts.push_back({distSq, i});
+    }
+
+    // nearest first, index breaks ties so the order never depends on the grid layout
+    std::sort(contacts.begin(), contacts.end(), [](const Contact& a, const Contact& b) {
+        return a.distSq != b.distSq ? a.distSq < b.distSq : a.index < b.index;
+    });
+    for (const Contact& contact : contacts) {
+        out.push_back(aquarium->getCreatureHandleAt(contact.index));
+    }
+    return (int)out.size();
+}
+
+// power up methods inside aquarium
+void Aquarium::addPowerUp(std::shared_ptr<PowerUp> pu) {
+    m_powerups.push_back(std::move(pu));
+}
+
+std::shared_ptr<AquariumLevel> Aquarium::getActiveLevel() const {
+    if (m_aquariumlevels.empty()) return nullptr;
+    return m_aquariumlevels[this->currentLevel % m_aquariumlevels.size()];
+}
+
+int Aquarium::getPowerUpCount() const {
+    return (int)m_powerups.size();
+}
+
+std::shared_ptr<PowerUp> Aquarium::getPowerUpAt(int i) {
+    if (i < 0 || (size_t)i >= m_powerups.size()) return nullptr;
+    return m_powerups[i];
+}
+
+void Aquarium::removePowerUp(const std::shared_ptr<PowerUp>& pu) {
+    auto it = std::find(m_powerups.begin(), m_powerups.end(), pu);
+    if (it != m_powerups.end()) m_powerups.erase(it);
+};
+
+//  Imlementation of the AquariumScene
+
+// adds the wall time of its scope to *target in microseconds, does nothing when target is null
+class ScenePhaseTimer {
+    public:
+        explicit ScenePhaseTimer(double* target) : m_target(target) {
+            if (m_target) m_start = std::chrono::steady_clock::now();
+        }
+        ~ScenePhaseTimer() {
+            if (!m_target) return;
+            auto elapsed = std::chrono::steady_clock::now() - m_start;
+            *m_target += std::chrono::duration<double, std::micro>(elapsed).count();
+        }
+    private:
+        double* m_target;
+        std::chrono::steady_clock::time_point m_start;
+};
+
+void AquariumGameScene::ApplyInput(AquariumInput input, bool pressed){
+    PlayerCreature& player = *this->m_player;
+    switch (input) {
+        case AquariumInput::Up:
+        case AquariumInput::Down: {
+            float dy = !pressed ? 0 : input == AquariumInput::Up ? -1 : 1;
+            player.setDirection(player.isXDirectionActive() ? player.getDx() : 0, dy);
+            break;
+        }
+        case AquariumInput::Left:
+        case AquariumInput::Right: {
+            float dx = !pressed ? 0 : input == AquariumInput::Left ? -1 : 1;
+            player.setDirection(dx, player.isYDirectionActive() ? player.getDy() : 0);
+            if (pressed) player.setFlipped(input == AquariumInput::Left);
+            break;
+        }
+        case AquariumInput::GrowPopulation:
+            if (pressed) this->m_aquarium->scaleLevelPopulations(2); // stress the renderer, refills next step
+            return;
+        case AquariumInput::ResetPopulation:
+            if (pressed) this->m_aquarium->resetLevelPopulations();
+            return;
+    }
+    player.move();
+}
+
+void AquariumGameScene::Resize(int width, int height){
+    this->m_aquarium->setBounds(width, height);
+    this->m_player->setBounds(width - 20, height - 20);
+}
+
+void AquariumGameScene::Update(){
+    AQ_PROFILE_SCOPE("AquariumGameScene::Update");
+    AquariumSceneTimings* timings = this->m_collectTimings ? &this->m_timings : nullptr;
+    if (timings) timings->ticks++;
+    
+    {
+    ScenePhaseTimer phase(timings ? &timings->playerUs : nullptr);
+    this->m_player->update();
+    }
+
+    {
+    ScenePhaseTimer phase(timings ? &timings->powerUpUs : nullptr);
+    // a BiggerFish showing up means the harder levels have started, the power-up follows
+    // 10 seconds after the first one and never again this game
+    if (this->m_bigFishTicks < 0 && this->m_aquarium->getCreatureCount(AquariumCreatureType::BiggerFish) > 0) {
+        this->m_bigFishTicks = 0;
+    }
+    if (this->m_bigFishTicks >= 0 && !this->m_powerUpSpawned
+        && ++this->m_bigFishTicks > this->m_aquarium->getPace().ticks(10*60)) {
+        float px = m_player->getX(), py = m_player->getY();
+        const float margin = 20.0f;
+        float x = std::clamp(px + 150.0f, margin, float(m_aquarium->getWidth()  - margin));
+        float y = std::clamp(py + 100.0f, margin, float(m_aquarium->getHeight() - margin));
+
+        m_aquarium->addPowerUp(std::make_shared<PowerUp>(x, y, 16.0f, AQUARIUM_POWER_UP_SPRITE));
+        this->m_powerUpSpawned = true;
+        AQ_LOG_NOTICE("Power UP spawned 10s after the first BiggerFish");
+    }
+    }
+
+    {
+    ScenePhaseTimer phase(timings ? &timings->collisionUs : nullptr);
+    // every contact this tick, eating one can't invalidate the others since they're handles;
+    // the list is ours, so none of them get lost however busy the event bus is
+    DetectAquariumCollisions(this->m_aquarium, this->m_player, this->m_contacts);
+    for (CreatureHandle contact : this->m_contacts) {
+        GameEvent event(GameEventType::COLLISION, this->m_player->getHandle(), contact);
+        this->m_events.publish(event); // for listeners, the scene doesn't read it back
+        AQ_LOG_VERBOSE("Collision detected between player and NPC!");
+        Creature* creatureB = this->m_aquarium->resolve(contact);
+        if(creatureB != nullptr){
+            event.print(this->m_aquarium->getRegistry());
+            int value = creatureB->getValue(); // read before removal, the creature may be freed
+            if(this->m_player->getPower() < value){
+                AQ_LOG_VERBOSE("Player is too weak to eat the creature!");
+                this->m_player->loseLife(this->m_aquarium->getPace().ticks(3*60)); // 3 seconds of debounce
+                if(this->m_player->getLives() <= 0){
+                    this->m_events.publish(GameEvent(GameEventType::GAME_OVER, this->m_player->getHandle(), CreatureHandle()));
+                    return;
+                }
+            }
+            else{
+                this->m_aquarium->removeCreature(contact);
+                this->m_player->addToScore(1, value);
+                if (this->m_player->getScore() % 25 == 0){
+                    this->m_player->increasePower(1);
+                    AQ_LOG_VERBOSE("Player power increased to {}!", this->m_player->getPower());
+                }
+                
+            }
+            
+            
+
+        } else {
+            AQ_LOG_ERROR("Error: creatureB is null in collision event.");
+        }
+    }
+
+    // if collision with powerup is true then increase size and hitbox
+    for (int i = 0; i < this->m_aquarium->getPowerUpCount(); i++) {
+        auto pu = this->m_aquarium->getPowerUpAt(i);
+        if (!pu) continue;
+
+        float px = this->m_player->getX() + this->m_player->getCollisionRadius();
+        float py = this->m_player->getY() + this->m_player->getCollisionRadius();
+        float qx = pu->getX() + pu->getRadius();
+        float qy = pu->getY() + pu->getRadius();
+
+        float dx = px - qx;
+        float dy = py - qy;
+        float rr = this->m_player->getCollisionRadius() + pu->getRadius();
+
+        if (dx*dx + dy*dy <= rr*rr) {
+            m_player->setPermanentSize(1.5f); 
+
+            AQ_LOG_NOTICE("PowerUp collected! New collision radius -> {}", m_player->getCollisionRadius());
+
+            m_aquarium->removePowerUp(pu);
+            break;
+        }
+    }
+    }
+
+    // every tick like the player, speeds are scaled for it (see AquariumPace)
+    ScenePhaseTimer phase(timings ? &timings->aquariumUs : nullptr);
+    this->m_aquarium->update();
+
+}
+
+void AquariumGameScene::Draw() {
+    if (this->m_renderer) this->m_renderer->draw(*this);
+}
+
+void AquariumLevel::scalePopulation(int factor){
+    if (factor <= 0) return;
+    for(auto node: this->m_levelPopulation){
+        // checked before multiplying, so a big factor can't overflow past the cap
+        bool capped = node->population > kAquariumMaxTypePopulation / factor;
+        node->population = capped ? kAquariumMaxTypePopulation : node->population * factor;
+    }
+    this->scaleTargetScore();
+}
+
+void AquariumLevel::resetPopulationScale(){
+    for(auto node: this->m_levelPopulation){
+        node->population = node->basePopulation;
+    }
+    this->m_targetScore = this->m_baseTargetScore;
+}
+
+void AquariumLevel::scaleTargetScore(){
+    // the player eats in proportion to how crowded the level is, so the target grows by the
+    // same ratio as the whole population (caps included) and a level lasts about as long
+    int64_t population = 0;
+    int64_t basePopulation = 0;
+    for(auto node: this->m_levelPopulation){
+        population += node->population;
+        basePopulation += node->basePopulation;
+    }
+    if (basePopulation == 0) return;
+    int64_t target = (int64_t)this->m_baseTargetScore * population / basePopulation;
+    this->m_targetScore = (int)std::clamp<int64_t>(target, this->m_baseTargetScore, INT32_MAX);
+}
+
+void AquariumLevel::ConsumePopulation(AquariumCreatureType creatureType, int power){
+    if (this->m_nodeByType[(int)creatureType] < 0) return; // not one of ours
+    this->m_level_score += power;
+}
+
+void AquariumLevel::addPopulation(AquariumCreatureType type, int population){
+    int node = this->m_nodeByType[(int)type];
+    if (node >= 0) {
+        // one node per type, Repopulate and the snapshots only ever look at that one
+        this->m_levelPopulation[node]->population += population;
+        this->m_levelPopulation[node]->basePopulation += population;
+        return;
+    }
+    this->m_nodeByType[(int)type] = (int)this->m_levelPopulation.size();
+    this->m_levelPopulation.push_back(std::make_shared<AquariumLevelPopulationNode>(type, population));
+}
+
+bool AquariumLevel::isCompleted(){
+    return this->m_level_score >= this->m_targetScore;
+}
+
+
+void AquariumLevel::Repopulate(const Aquarium& aquarium, std::vector<AquariumSpawnBatch>& out) {
+    out.clear();
+    for (auto& f : m_levelPopulation) {
+        int delta = f->population - aquarium.getCreatureCount(f->creatureType);
+        if (delta > 0) out.push_back({f->creatureType, delta});
+    }
+}
+
+
+void LoadAquariumLevels(Aquarium& aquarium, const LevelPack& pack) {
+    for (int i = 0; i < pack.getLevelCount(); ++i) {
+        const LevelPackLevel& record = pack.getLevel(i);
+        auto level = std::make_shared<AquariumLevel>(record.number, record.targetScore);
+        level->setSpeedRange(record.minSpeed, record.maxSpeed);
+        const LevelPackPopulation* populations = pack.getPopulation(record);
+        for (uint32_t p = 0; p < record.populationCount; ++p) {
+            level->addPopulation((AquariumCreatureType)populations[p].creatureType, populations[p].count);
+        }
+        aquarium.addAquariumLevel(level);
+    }
+}
+
+// builds the aquarium, its levels and the player the same way for the game and the headless runner
+std::shared_ptr<AquariumGameScene> CreateAquariumGameScene(int width, int height, int playerSpeed, uint64_t seed, const LevelPack* levels,
+                                                           double tickHz) {
+    auto aquarium = std::make_shared<Aquarium>(width, height);
+    aquarium->setSeed(seed);
+    aquarium->setTickRate(tickHz);
+    auto player = std::make_shared<PlayerCreature>(width/2 - 50, height/2 - 50, playerSpeed,
+                                                   AquariumCreatureSprite(AquariumCreatureType::NPCreature));
+    player->setDirection(0, 0); // Initially stationary
+    player->setBounds(width - 20, height - 20);
+    player->setPace(aquarium->getPace());
+
+    LevelPack builtin;
+    if (!levels || levels->getLevelCount() == 0) {
+        std::string error;
+        if (!builtin.loadBuiltin(error)) {
+            AsyncLog::WriteText(LogLevel::Error, "built-in levels don't compile: " + error);
+        }
+        levels = &builtin;
+    }
+    LoadAquariumLevels(*aquarium, *levels);
+    aquarium->Repopulate(); // initial population
+    AQ_LOG_NOTICE("{} creatures in the first level", aquarium->getCreatureCount());
+
+    // player and aquarium are owned by the scene moving forward
+    return std::make_shared<AquariumGameScene>(
+        std::move(player), std::move(aquarium), GameSceneKindToString(GameSceneKind::AQUARIUM_GAME)
+    );
+}
@@ -0,0 +1,531 @@
+#pragma once
+
+#define NOMINMAX // To avoid min/max macro conflict on Windows
+
+#include <vector>
+#include <memory>
+#include <iostream>
+#include <algorithm>
+#include <iterator>
+#include <functional>
+#include <mutex>
+#include <cmath>
+#include "Core.h"
+#include "SpatialGrid.h"
+#include "WorkerPool.h"
+#include "CreaturePool.h"
+#include "EventBus.h"
+#include "CreatureGroups.h"
+
+
+enum class AquariumCreatureType {
+    NPCreature,
+    BiggerFish,
+    PinkFish,
+    SharkFish
+};
+constexpr int kAquariumCreatureTypeCount = 4;
+// a new type goes at the end of the enum, then everything sized by the count (pools, groups,
+// sprites, level populations) and the makeCreature switch have to grow with it
+static_assert((int)AquariumCreatureType::SharkFish == kAquariumCreatureTypeCount - 1, "count the last AquariumCreatureType");
+
+// Creature speeds, the pink wave and the shark dash timers were tuned for one aquarium step
+// every 6 scene ticks at 60 ticks a second, the player and its debounce for one move per tick.
+// The aquarium steps every tick now, at whatever rate the game runs the scene, so movement is
+// scaled down by the pace and frame counts scaled up, which keeps everything as fast in
+// seconds as it was without the stutter.
+constexpr double kAquariumDesignTickHz = 60.0;
+constexpr int kAquariumTicksPerStep = 6; // at kAquariumDesignTickHz
+
+struct AquariumPace {
+    float tickScale = 1.0f;                        // a design tick's worth of movement per tick
+    float stepScale = 1.0f / kAquariumTicksPerStep; // a tuned step's worth of movement per tick
+
+    static AquariumPace ForTickRate(double tickHz) {
+        AquariumPace pace;
+        pace.tickScale = (float)(kAquariumDesignTickHz / tickHz);
+        pace.stepScale = pace.tickScale / kAquariumTicksPerStep;
+        return pace;
+    }
+    // a count of design ticks as ticks at this rate, never less than one
+    int ticks(int designTicks) const { return std::max(1, (int)std::lround(designTicks / tickScale)); }
+};
+
+// sprite ids the aquarium hands out: one per creature type in AquariumCreatureType order (the
+// player looks like a base fish) and the power-up after them
+inline SpriteId AquariumCreatureSprite(AquariumCreatureType t) { return (SpriteId)t; }
+static const SpriteId AQUARIUM_POWER_UP_SPRITE = kAquariumCreatureTypeCount;
+constexpr int kAquariumSpriteCount = kAquariumCreatureTypeCount + 1;
+
+std::string AquariumCreatureTypeToString(AquariumCreatureType t);
+
+// scaling a level's populations for stress runs stops here, per type (the first level's
+// 10 fish times the 10000 the snapshot benchmark uses still fits)
+constexpr int kAquariumMaxTypePopulation = 100000;
+
+// how many of a type a level keeps alive, how many are alive right now is up to the Aquarium
+class AquariumLevelPopulationNode{
+    public:
+        AquariumLevelPopulationNode() = default;
+        AquariumLevelPopulationNode(AquariumCreatureType creature_type, int population) {
+            this->creatureType = creature_type;
+            this->population = population;
+            this->basePopulation = population;
+        };
+        AquariumCreatureType creatureType;
+        int population;
+        int basePopulation; // what the level pack asked for, before any scaling
+};
+
+class Aquarium;
+struct SnapshotPlayer;
+struct SnapshotWorld;
+struct SnapshotLevel;
+struct SnapshotPowerUp;
+struct SnapshotView;
+
+struct AquariumSpawnBatch {
+    AquariumCreatureType type;
+    int count;
+};
+
+class AquariumLevel : public GameLevel {
+    public:
+        AquariumLevel(int levelNumber, int targetScore)
+        : GameLevel(levelNumber), m_level_score(0), m_targetScore(targetScore), m_baseTargetScore(targetScore){
+            std::fill(std::begin(m_nodeByType), std::end(m_nodeByType), -1);
+        };
+        // a creature of this type was eaten, scores only if the level has the type at all
+        void ConsumePopulation(AquariumCreatureType creature, int power);
+        bool isCompleted() override;
+        void levelReset(){m_level_score=0;}
+        // multiplies every node's population for stress runs, capped at kAquariumMaxTypePopulation;
+        // the target score follows, so a denser level doesn't end after a tick or two
+        void scalePopulation(int factor);
+        void resetPopulationScale(); // back to the level pack's populations
+        // what has to be spawned to bring the aquarium's live counts back up to the level's
+        // populations, one (type, count) batch per short type; out is cleared first
+        virtual void Repopulate(const Aquarium& aquarium, std::vector<AquariumSpawnBatch>& out);
+        // filled in from a level pack record, see LoadAquariumLevels; a type that is already
+        // there gets the population added to its node
+        void addPopulation(AquariumCreatureType type, int population);
+        void setSpeedRange(int minSpeed, int maxSpeed){m_minSpeed = minSpeed; m_maxSpeed = maxSpeed;}
+        int getMinSpeed() const {return m_minSpeed;}
+        int getMaxSpeed() const {return m_maxSpeed;}
+        // progress and (possibly scaled) populations, for snapshots
+        int getScore() const {return m_level_score;}
+        int getTargetScore() const {return m_targetScore;}
+        void setScore(int score){m_level_score = score;}
+        int getPopulation(AquariumCreatureType type) const; // -1 when the level has no such fish
+        void setPopulation(AquariumCreatureType type, int population);
+    protected:
+        void scaleTargetScore(); // by how much the populations grew over the pack's
+        std::vector<std::shared_ptr<AquariumLevelPopulationNode>> m_levelPopulation;
+        int m_nodeByType[kAquariumCreatureTypeCount]; // index into m_levelPopulation, -1 for none
+        int m_level_score;
+        int m_targetScore;
+        int m_baseTargetScore; // the level pack's, scaled along with the populations
+        int m_minSpeed = 1;
+        int m_maxSpeed = 25;
+
+};
+
+
+class PlayerCreature : public Creature {
+public:
+
+    PlayerCreature(float x, float y, int speed, SpriteId sprite);
+    void setPace(const AquariumPace& pace) { m_tickScale = pace.tickScale; }
+    void move();
+    void update();
+    void changeSpeed(int speed);
+    void setLives(int lives) { m_lives = lives; }
+    void setDirection(float dx, float dy);
+    float isXDirectionActive() { return m_dx != 0; }
+    float isYDirectionActive() {return m_dy != 0; }
+    float getDx() { return m_dx; }
+    float getDy() { return m_dy; }
+
+    int getScore()const { return m_score; }
+    int getLives() const { return m_lives; }
+    int getPower() const { return m_power; }
+    // the renderer flashes the player while this counts down and draws it this much bigger
+    int getDamageDebounce() const { return m_damage_debounce; }
+    float getVisualScale() const { return m_visualScale; }
+    
+    void addToScore(int amount, int weight=1) { m_score += amount * weight; }
+    void loseLife(int debounce);
+    void increasePower(int value) { m_power += value; }
+    void reduceDamageDebounce();
+    void setPermanentSize(float scaleUp); // set the powerup buffs (size incr)
+    void saveSnapshot(SnapshotPlayer& out) const;
+    void loadSnapshot(const SnapshotPlayer& in);
+    
+private:
+    int m_score = 0;
+    int m_lives = 3;
+    int m_power = 1; // mark current power lvl
+    int m_damage_debounce = 0; // frames to wait after eating
+    float m_visualScale = 1.0f; //default val to change fish size w/o changing png
+    float m_tickScale = 1.0f; // see AquariumPace
+};
+
+class NPCreature : public Creature {
+public:
+    NPCreature(float x, float y, int speed, SpriteId sprite, RandomStream rng = RandomStream(), const AquariumPace& pace = AquariumPace());
+    AquariumCreatureType GetType() const {return this->m_creatureType;}
+    // the Aquarium hands its own down, timers already running keep the length they got
+    void setPace(const AquariumPace& pace) { m_pace = pace; }
+    void move() override;
+protected:
+    void saveExtraState(CreatureStore& store, int slot) const override { store.rng[slot] = m_rng; }
+    void loadExtraState(const CreatureStore& store, int slot) override { m_rng = store.rng[slot]; }
+
+    AquariumCreatureType m_creatureType;
+    RandomStream m_rng; // this creature's own substream, handed out by the Aquarium
+    AquariumPace m_pace;
+
+};
+
+class BiggerFish final : public NPCreature {
+public:
+    BiggerFish(float x, float y, int speed, SpriteId sprite, RandomStream rng = RandomStream(), const AquariumPace& pace = AquariumPace());
+    void move() override;
+};
+
+class PinkFish final : public NPCreature {
+public:
+    PinkFish(float x, float y, int speed, SpriteId sprite, RandomStream rng = RandomStream(), const AquariumPace& pace = AquariumPace());
+    void move() override;
+
+    protected:
+    void saveExtraState(CreatureStore& store, int slot) const override {
+        NPCreature::saveExtraState(store, slot);
+        store.phase[slot] = t;
+    }
+    void loadExtraState(const CreatureStore& store, int slot) override {
+        NPCreature::loadExtraState(store, slot);
+        t = store.phase[slot];
+    }
+
+    private:
+    float t = 0.0f;
+};
+
+class SharkFish final : public NPCreature {
+public:
+    SharkFish(float x, float y, int speed, SpriteId sprite, RandomStream rng = RandomStream(), const AquariumPace& pace = AquariumPace());
+    void move() override;
+
+    protected:
+    void saveExtraState(CreatureStore& store, int slot) const override {
+        NPCreature::saveExtraState(store, slot);
+        store.dashFrames[slot] = dashFrames;
+        store.cooldownFrames[slot] = cooldownFrames;
+    }
+    void loadExtraState(const CreatureStore& store, int slot) override {
+        NPCreature::loadExtraState(store, slot);
+        dashFrames = store.dashFrames[slot];
+        cooldownFrames = store.cooldownFrames[slot];
+    }
+
+    private:
+    int dashFrames = 0;       
+    int cooldownFrames = 0;
+};
+
+// the concrete creature classes in AquariumCreatureType order, a new type gets appended here too
+using AquariumCreatureGroups = CreatureGroups<NPCreature, BiggerFish, PinkFish, SharkFish>;
+static_assert(AquariumCreatureGroups::kCount == kAquariumCreatureTypeCount, "one group per AquariumCreatureType");
+
+class LevelPack;
+
+// everything that happens in a game scene is announced on one of these for whoever listens
+// (ofApp, the headless runner); the scene itself resolves its collisions from its own list,
+// so a tick that publishes more than the ring holds only costs listeners some notifications.
+// Spawns go out as one event per batch, so a refill of any size fits
+using GameEventBus = EventRing<GameEvent, 4096>;
+
+class PowerUp {
+public:
+    PowerUp(float x, float y, float r, SpriteId sprite);
+    float getX() const;
+    float getY() const;
+    float getRadius() const;
+    SpriteId getSprite() const { return m_sprite; }
+
+private:
+    float m_x, m_y, m_radius;
+    SpriteId m_sprite;
+};
+// how an Aquarium keeps its creatures' state
+// Objects: every creature owns its state and is moved through its own class's move(), one type at a time (default)
+// Arrays: state is kept in a CreatureStore and moved in per-type batches, no virtual calls
+enum class CreatureStorage {
+    Objects,
+    Arrays
+};
+
+// running totals for the performance overlay, they only ever go up
+struct AquariumCounters {
+    uint64_t added = 0;
+    uint64_t removed = 0;         // eaten plus cleared on level up
+    uint64_t collisionTests = 0;  // candidates the spatial index handed to collision detection
+    uint64_t collisionPasses = 0;
+    uint64_t gridCellMoves = 0;   // creatures the spatial index moved to another cell
+    uint64_t gridRebuilds = 0;    // full spatial index builds: first use, resizes, restores
+};
+
+class Aquarium{
+public:
+    Aquarium(int width, int height);
+    ~Aquarium() { m_store.clear(); m_groups.clear(); m_registry.clear(); } // creatures may outlive us, give them their state back
+    void addCreature(std::shared_ptr<Creature> creature);
+    void addAquariumLevel(std::shared_ptr<AquariumLevel> level);
+    void scaleLevelPopulations(int factor);
+    // undoes scaleLevelPopulations, the extra creatures stay until they're eaten or the level ends
+    void resetLevelPopulations();
+    void removeCreature(CreatureHandle handle);
+    void clearCreatures();
+    void update();
+    void setBounds(int w, int h);
+    void setStorage(CreatureStorage storage);
+    CreatureStorage getStorage() const { return m_storage; }
+    // threads used to move creatures in update(), 1 keeps everything on the calling thread
+    void setThreadCount(int threads);
+    int getThreadCount() const;
+    void setMaxPopulation(int n) { m_maxPopulation = n; }
+    // restarts the aquarium's random stream, spawns made afterwards are fully determined by the seed
+    void setSeed(uint64_t seed) { m_seed = seed; m_rng = RandomStream(seed, 0); m_spawnCount = 0; }
+    uint64_t getSeed() const { return m_seed; }
+    // ticks per second the owner calls update() at, every creature's movement and timers
+    // follow it; set it before the first spawn, see AquariumPace
+    void setTickRate(double tickHz);
+    const AquariumPace& getPace() const { return m_pace; }
+    // block pool backing every spawned creature of this type (see SpawnCreature)
+    const BlockPool& getCreaturePool(AquariumCreatureType type) const { return *m_pools[(int)type]; }
+    // levels up when the level is done and spawns whatever is missing, update() only calls it
+    // after a removal, a level change or a population change so idle ticks skip it
+    void Repopulate();
+    void SpawnCreature(AquariumCreatureType type) { this->SpawnCreatures(type, 1); }
+    // spawns count creatures in a row; Repopulate reserves room for all of its batches before
+    // calling this, anyone else leaves the growing to the containers
+    void SpawnCreatures(AquariumCreatureType type, int count);
+    void addPowerUp(std::shared_ptr<PowerUp> pu);
+    void removePowerUp(const std::shared_ptr<PowerUp>& pu);
+    
+    std::shared_ptr<Creature> getCreatureAt(int index);
+    CreatureHandle getCreatureHandleAt(int index) const;
+    // handles of removed creatures resolve to nullptr
+    Creature* resolve(CreatureHandle handle) const { return m_registry.resolve(handle); }
+    const CreatureRegistry& getRegistry() const { return m_registry; }
+    // CREATURE_ADDED per addCreature call, CREATURES_SPAWNED per SpawnCreatures batch (not per
+    // creature), CREATURE_REMOVED per creature and NEW_LEVEL (which also clears the creatures,
+    // those don't get removal events) are published here when set
+    void setEventBus(GameEventBus* events) { m_events = events; }
+    // registers something that is not one of our creatures (the player) so events can refer to it
+    CreatureHandle trackExternal(Creature* creature) { return m_registry.add(creature); }
+    // the owner calls this before the creature goes away, the registry never outlives it then
+    void untrackExternal(Creature* creature) { m_registry.remove(creature->getHandle()); }
+    std::shared_ptr<PowerUp> getPowerUpAt(int i);
+    const std::vector<std::shared_ptr<PowerUp>>& getPowerUps() const { return m_powerups; }
+    int getCreatureCount() const { return m_creatures.size(); }
+    // live creatures by type, kept up to date on every spawn and removal so these are O(1)
+    int getCreatureCount(AquariumCreatureType type) const { return m_groups.size((int)type); }
+    // e.g. getCreatures<AquariumCreatureType::PinkFish>() is a std::vector<PinkFish*>, only valid until the next add/remove
+    template <AquariumCreatureType Type> const auto& getCreatures() const { return m_groups.get<(int)Type>(); }
+    const AquariumCreatureGroups& getCreatureGroups() const { return m_groups; }
+    // every creature in aquarium order: spawn order, except a removal moves the last one into
+    // its place; the store keeps its slots in the same order
+    const std::vector<std::shared_ptr<Creature>>& getAllCreatures() const { return m_creatures; }
+    // where the state is with array storage, packed in slot order
+    const CreatureStore& getStore() const { return m_store; }
+    int getWidth() const { return m_width; }
+    int getCurrentLevel() const { return currentLevel; }
+    std::shared_ptr<AquariumLevel> getActiveLevel() const;
+    int getHeight() const { return m_height; }
+    int getPowerUpCount() const;
+    const AquariumCounters& getCounters() const { return m_counters; }
+    int getLevelCount() const { return (int)m_aquariumlevels.size(); }
+    int getLevelScore(int level) const { return m_aquariumlevels[level]->getScore(); }
+
+    // snapshot sections, see Snapshot.h; sized by getLevelCount, getPowerUpCount and
+    // CreatureStore::PackedSize(getCreatureCount())
+    void saveSnapshot(SnapshotWorld& world, SnapshotLevel* levels, SnapshotPowerUp* powerUps, uint8_t* creatures) const;
+    // the view has to match our level count. Creature objects are reused by type, only a
+    // difference in the per-type counts takes blocks from (or gives them back to) the pools
+    void restoreSnapshot(const SnapshotView& view);
+    void noteCollisionTests(int candidates) { m_counters.collisionTests += candidates; m_counters.collisionPasses++; }
+
+    // spatial queries, both fill `out` with creature indices usable with getCreatureAt
+    // queryRadius returns creatures whose collision circle touches the given circle
+    // queryAABB returns creatures whose position lies inside the box
+    int queryRadius(float x, float y, float radius, std::vector<int>& out);
+    int queryAABB(float minX, float minY, float maxX, float maxY, std::vector<int>& out);
+
+
+private:
+    struct GridMove { int id; int cell; };
+    struct GridPoint { float x, y, r; }; // together, a query candidate is one cache line
+    void refreshSpatialIndex();
+    float spatialCellSize() const { return std::max(2.0f * m_maxCollisionRadius, 32.0f); }
+    // called for every creature from the movement pass, collects the ones that changed cell
+    void trackGridPosition(int index, float x, float y, std::vector<GridMove>& moves) {
+        if (m_gridDirty) return; // rebuilt in full on the next query anyway
+        m_gridPoints[index].x = x;
+        m_gridPoints[index].y = y;
+        int cell = m_grid.cellAt(x, y);
+        if (cell != m_grid.cellOf(index)) moves.push_back({index, cell});
+    }
+    void queueGridMoves(const std::vector<GridMove>& moves);
+    void applyGridMoves();
+    void updateArrays(int begin, int end);
+    void forEachChunk(int count, const std::function<void(int, int)>& fn);
+    // a pooled creature of the given class, not added to anything yet
+    void insertCreature(std::shared_ptr<Creature> creature); // addCreature without the event
+    std::shared_ptr<Creature> makeCreature(AquariumCreatureType type, int x, int y, int speed, RandomStream rng);
+    // restore: takes the creature at index out of everything and keeps it as a spare of its type
+    void spareForSnapshot(int index, int type);
+
+    int m_maxPopulation = 0;
+    int m_width;
+    int m_height;
+    int currentLevel = 0;
+    std::vector<std::shared_ptr<Creature>> m_creatures;
+    AquariumCreatureGroups m_groups; // the same creatures by concrete type, for update and drawing
+    CreatureRegistry m_registry;
+    GameEventBus* m_events = nullptr;
+    AquariumCounters m_counters;
+    std::vector<std::shared_ptr<Creature>> m_next_creatures;
+    std::vector<std::shared_ptr<AquariumLevel>> m_aquariumlevels;
+    bool m_repopulatePending = true;              // something changed that Repopulate has to look at
+    std::vector<AquariumSpawnBatch> m_spawnBatches; // reused between calls to Repopulate
+    std::vector<std::shared_ptr<PowerUp>> m_powerups;
+
+    uint64_t m_seed = 1;
+    RandomStream m_rng{1, 0};
+    uint64_t m_spawnCount = 0; // also the substream id of the next creature
+    AquariumPace m_pace;
+
+    CreatureStorage m_storage = CreatureStorage::Objects;
+    CreatureStore m_store;
+    std::unique_ptr<WorkerPool> m_workers; // null when single threaded
+
+    // one pool per AquariumCreatureType, spawned creatures and their shared_ptr control blocks live here
+    std::shared_ptr<BlockPool> m_pools[kAquariumCreatureTypeCount];
+
+    // spatial index: built in full the first time it is queried after its layout changed (the
+    // bounds, the cell size, a restore), otherwise kept current by update(), spawns and removals
+    SpatialGrid m_grid;
+    bool m_gridDirty = true;
+    float m_maxCollisionRadius = 0.0f; // of the creatures in the aquarium, exact again after each rebuild
+    std::vector<GridPoint> m_gridPoints; // by creature index, sized even while m_gridDirty
+    std::vector<GridMove> m_gridMoves; // cell changes collected by the movement chunks
+    std::mutex m_gridMovesLock;
+
+    // snapshot scratch, kept so repeated saves and restores don't allocate
+    mutable CreatureStore m_snapshotStore;
+    std::vector<std::shared_ptr<Creature>> m_snapshotSpares[kAquariumCreatureTypeCount];
+    std::vector<int> m_snapshotRefill; // indices a restore took the creature from, ascending
+};
+
+
+// every creature touching the player, nearest first, into contacts (cleared first); returns how many
+int DetectAquariumCollisions(std::shared_ptr<Aquarium> aquarium, std::shared_ptr<PlayerCreature> player, std::vector<CreatureHandle>& contacts);
+
+
+// wall-clock time spent in each part of AquariumGameScene::Update, only collected when enabled
+struct AquariumSceneTimings {
+    int ticks = 0;      // Update calls
+    double playerUs = 0;
+    double powerUpUs = 0;
+    double collisionUs = 0;
+    double aquariumUs = 0;
+};
+
+// what the player can do to a running AquariumGameScene. ofApp maps keys onto these and the
+// replay recorder stores them, so a session plays back the same without a window
+enum class AquariumInput : uint8_t {
+    Up,
+    Down,
+    Left,
+    Right,
+    GrowPopulation, // ']' doubles every level's population
+    ResetPopulation, // '[' puts them back to the level pack's
+};
+
+class AquariumGameScene;
+
+// Draws a scene from its state, the simulation itself never draws anything. The game sets
+// one on its scene (AquariumRenderer, see AquariumRender.h), headless scenes go without.
+class AquariumSceneRenderer {
+public:
+    virtual ~AquariumSceneRenderer() = default;
+    virtual void draw(const AquariumGameScene& scene) = 0;
+};
+
+class AquariumGameScene : public GameScene {
+    public:
+        AquariumGameScene(std::shared_ptr<PlayerCreature> player, std::shared_ptr<Aquarium> aquarium, std::string name)
+        : m_player(std::move(player)) , m_aquarium(std::move(aquarium)), m_name(name){
+            this->m_aquarium->trackExternal(this->m_player.get());
+            this->m_aquarium->setEventBus(&this->m_events);
+        }
+        // the aquarium can outlive us (it's shared), so it forgets the player and our bus here
+        // rather than relying on the order the members get destroyed in
+        ~AquariumGameScene() {
+            this->m_aquarium->untrackExternal(this->m_player.get());
+            this->m_aquarium->setEventBus(nullptr);
+        }
+        // ofApp and the headless runner keep their own reader on this to catch GAME_OVER
+        const GameEventBus& GetEvents() const {return this->m_events;}
+        std::shared_ptr<PlayerCreature> GetPlayer() const {return this->m_player;}
+        std::shared_ptr<Aquarium> GetAquarium() const {return this->m_aquarium;}
+        std::string GetName()override {return this->m_name;}
+        void SetCollectTimings(bool enabled){this->m_collectTimings = enabled;}
+        // fraction of a simulation tick elapsed since the last Update, used to interpolate Draw
+        void SetInterpolation(float alpha){this->m_interpolation = alpha;}
+        float GetInterpolation() const {return this->m_interpolation;}
+        // Draw does nothing without one
+        void SetRenderer(std::shared_ptr<AquariumSceneRenderer> renderer){this->m_renderer = std::move(renderer);}
+        void ToggleDebugOverlay(){this->m_showDebug = !this->m_showDebug;}
+        bool IsDebugOverlayVisible() const { return this->m_showDebug; }
+        const AquariumSceneTimings& GetTimings() const {return this->m_timings;}
+        // a key going down (pressed) or up; steers the player and nudges it one step right away
+        void ApplyInput(AquariumInput input, bool pressed);
+        // window size changed, the aquarium walls and the player's bounds follow it
+        void Resize(int width, int height);
+        // the whole simulation state, see Snapshot.h; out is resized (and reused when big enough)
+        void SaveSnapshot(std::vector<uint8_t>& out) const;
+        // puts the scene back to where the snapshot was taken, the scene has to have the
+        // same levels and aquarium size; nothing changes when it returns false
+        bool RestoreSnapshot(const uint8_t* data, size_t size, std::string& error);
+        void Update() override;
+        void Draw() override;
+    private:
+        std::shared_ptr<PlayerCreature> m_player;
+        std::shared_ptr<Aquarium> m_aquarium;
+        GameEventBus m_events;
+        std::vector<CreatureHandle> m_contacts; // this tick's collisions, reused between ticks
+        std::string m_name;
+        float m_interpolation = 1.0f;
+        bool m_showDebug = false;
+        std::shared_ptr<AquariumSceneRenderer> m_renderer;
+
+        // the size power-up, once per game, a while after the first BiggerFish shows up
+        int m_bigFishTicks = -1; // ticks since that sighting, -1 until then
+        bool m_powerUpSpawned = false;
+
+        bool m_collectTimings = false;
+        AquariumSceneTimings m_timings;
+};
+
+// adds one AquariumLevel per pack record, in pack order
+void LoadAquariumLevels(Aquarium& aquarium, const LevelPack& pack);
+
+// the aquarium with all its levels plus the player, ready to play (set a renderer to see it);
+// levels null means the built-in levels (LevelPack::BuiltinSource); tickHz is how often the
+// owner will call Update
+std::shared_ptr<AquariumGameScene> CreateAquariumGameScene(int width, int height, int playerSpeed, uint64_t seed, const LevelPack* levels = nullptr,
+                                                           double tickHz = kAquariumDesignTickHz);
+
@@ -0,0 +1,655 @@
+#include "Benchmark.h"
+#include "Aquarium.h"
+#include "Kinematics.h"
+#include "Snapshot.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <functional>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+
+namespace {
+
+using BenchClock = std::chrono::steady_clock;
+
+double elapsedNs(BenchClock::time_point start) {
+    return (double)std::chrono::duration_cast<std::chrono::nanoseconds>(BenchClock::now() - start).count();
+}
+
+// brute force reference with the same acceptance test as Aquarium::queryRadius
+int linearRadiusQuery(Aquarium& aquarium, float x, float y, float radius) {
+    int hits = 0;
+    for (int i = 0; i < aquarium.getCreatureCount(); ++i) {
+        auto c = aquarium.getCreatureAt(i);
+        float dx = c->getX() - x;
+        float dy = c->getY() - y;
+        float r = radius + c->getCollisionRadius();
+        if (dx * dx + dy * dy <= r * r) ++hits;
+    }
+    return hits;
+}
+
+// keeps a fixed mixed population alive so Aquarium::update has a level to repopulate from
+class BenchLevel : public AquariumLevel {
+    public:
+        BenchLevel(int population) : AquariumLevel(0, 1 << 30) {
+            int quarter = population / 4;
+            this->addPopulation(AquariumCreatureType::NPCreature, population - 3 * quarter);
+            this->addPopulation(AquariumCreatureType::BiggerFish, quarter);
+            this->addPopulation(AquariumCreatureType::PinkFish, quarter);
+            this->addPopulation(AquariumCreatureType::SharkFish, quarter);
+        }
+};
+
+} // namespace
+
+int RunSpatialGridBenchmark() {
+    // density is held at roughly a full 1024x768 screen per 1000 fish so
+    // the expected number of neighbours per query stays the same at every size
+    const int sizes[] = {1000, 10000, 100000};
+    const int queries = 20000;
+    const float playerRadius = 10.0f;
+
+    const int ticks = 100;
+
+    std::printf("%10s %12s %16s %12s %14s %12s %14s %10s\n", "creatures", "build(us)", "upkeep(us/tick)", "moves/tick",
+                "grid(ns/q)", "grid vs 1k", "linear(ns/q)", "hits/q");
+    double firstGridNs = 0;
+    for (int n : sizes) {
+        float scale = std::sqrt(n / 1000.0f);
+        int width = (int)(1024 * scale);
+        int height = (int)(768 * scale);
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> px(0.0f, (float)width);
+        std::uniform_real_distribution<float> py(0.0f, (float)height);
+
+        Aquarium aquarium(width, height);
+        for (int i = 0; i < n; ++i) {
+            aquarium.addCreature(std::make_shared<NPCreature>(px(rng), py(rng), 1, NO_SPRITE));
+        }
+
+        std::vector<int> out;
+        auto start = BenchClock::now();
+        aquarium.queryRadius(0, 0, playerRadius, out); // first query pays for the rebuild
+        double buildNs = elapsedNs(start);
+
+        // the points are drawn up front so only the queries are timed; best of a few passes,
+        // the per-query cost is meant to stay about the same from the smallest size up
+        std::vector<float> qx(queries), qy(queries);
+        for (int q = 0; q < queries; ++q) {
+            qx[q] = px(rng);
+            qy[q] = py(rng);
+        }
+        long long hits = 0;
+        double gridNs = std::numeric_limits<double>::max();
+        for (int pass = 0; pass < 5; ++pass) {
+            hits = 0;
+            start = BenchClock::now();
+            for (int q = 0; q < queries; ++q) {
+                hits += aquarium.queryRadius(qx[q], qy[q], playerRadius, out);
+            }
+            gridNs = std::min(gridNs, elapsedNs(start) / queries);
+        }
+        if (firstGridNs == 0) firstGridNs = gridNs;
+
+        // the linear scan gets far fewer iterations, it is only there for comparison
+        int linearQueries = std::max(10, queries * 1000 / n / 10);
+        long long linearHits = 0;
+        start = BenchClock::now();
+        for (int q = 0; q < linearQueries; ++q) {
+            linearHits += linearRadiusQuery(aquarium, px(rng), py(rng), playerRadius);
+        }
+        double linearNs = elapsedNs(start) / linearQueries;
+
+        // what keeping the index current costs a tick: the same swimming population once with a
+        // query after every update, as the game does, and once never queried, where update()
+        // leaves the cells alone; a full build only happens again after a resize or a restore
+        // best of a few alternating runs each, the difference is small next to the noise
+        double tickNs[2] = {std::numeric_limits<double>::max(), std::numeric_limits<double>::max()};
+        uint64_t moves = 0;
+        uint64_t rebuilds = 0;
+        for (int run = 0; run < 6; ++run) {
+            int indexed = run % 2;
+            Aquarium swimming(width, height);
+            swimming.setSeed(42);
+            swimming.addAquariumLevel(std::make_shared<BenchLevel>(n));
+            swimming.Repopulate();
+            if (indexed) swimming.queryRadius(0, 0, playerRadius, out);
+            AquariumCounters before = swimming.getCounters();
+            start = BenchClock::now();
+            for (int t = 0; t < ticks; ++t) {
+                swimming.update();
+                if (indexed) swimming.queryRadius(px(rng), py(rng), playerRadius, out);
+            }
+            tickNs[indexed] = std::min(tickNs[indexed], elapsedNs(start) / ticks);
+            if (indexed) {
+                moves = swimming.getCounters().gridCellMoves - before.gridCellMoves;
+                rebuilds += swimming.getCounters().gridRebuilds - before.gridRebuilds;
+            }
+        }
+        if (rebuilds > 0) std::fprintf(stderr, "grid was rebuilt %llu times while swimming\n", (unsigned long long)rebuilds);
+
+        std::printf("%10d %12.1f %16.1f %12.1f %14.1f %11.2fx %14.1f %10.2f\n", n, buildNs / 1000.0, std::max(tickNs[1] - tickNs[0], 0.0) / 1000.0,
+                    (double)moves / ticks, gridNs, gridNs / firstGridNs, linearNs, (double)hits / queries);
+        (void)linearHits;
+    }
+    return 0;
+}
+
+int RunStorageBenchmark() {
+    const int sizes[] = {50000, 100000};
+    const int ticks = 200;
+
+    std::printf("%10s %14s %14s %8s\n", "creatures", "objects(ms)", "arrays(ms)", "speedup");
+    for (int n : sizes) {
+        double msPerTick[2] = {0, 0};
+        CreatureStorage modes[2] = {CreatureStorage::Objects, CreatureStorage::Arrays};
+        for (int m = 0; m < 2; ++m) {
+            Aquarium aquarium(4096, 4096);
+            aquarium.setSeed(42);
+            aquarium.setStorage(modes[m]);
+            aquarium.addAquariumLevel(std::make_shared<BenchLevel>(n));
+            aquarium.Repopulate();
+            aquarium.update(); // warm up
+
+            auto start = BenchClock::now();
+            for (int t = 0; t < ticks; ++t) {
+                aquarium.update();
+            }
+            msPerTick[m] = elapsedNs(start) / ticks / 1e6;
+        }
+        std::printf("%10d %14.3f %14.3f %7.2fx\n", n, msPerTick[0], msPerTick[1], msPerTick[0] / msPerTick[1]);
+    }
+    return 0;
+}
+
+int RunKinematicsBenchmark() {
+    // odd count so the scalar tails of the vector kernels get exercised too
+    const int n = 100003;
+    const int steps = 500;
+    const float tolerance = 1e-3f;
+
+    struct Arrays {
+        std::vector<float> x, y, dx, dy, sx, sy, oy;
+        std::vector<uint8_t> flipped;
+        KinematicsBatch batch() {
+            return KinematicsBatch{x.data(), y.data(), dx.data(), dy.data(),
+                                   sx.data(), sy.data(), oy.data(), flipped.data(),
+                                   (int)x.size(), 1004.0f, 748.0f};
+        }
+    };
+
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> pos(0.0f, 1000.0f);
+    std::uniform_real_distribution<float> dir(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> speed(1.0f, 25.0f);
+    Arrays initial;
+    for (int i = 0; i < n; ++i) {
+        initial.x.push_back(pos(rng));
+        initial.y.push_back(pos(rng) * 0.75f);
+        initial.dx.push_back(i % 7 == 0 ? 0.0f : dir(rng)); // some creatures only move vertically
+        initial.dy.push_back(dir(rng));
+        float s = speed(rng);
+        initial.sx.push_back(s);
+        initial.sy.push_back(i % 4 == 2 ? s * 0.5f : s); // pink-style half vertical speed
+        initial.oy.push_back(i % 4 == 2 ? dir(rng) : 0.0f);
+    }
+    initial.flipped.assign(n, 0);
+
+    Arrays reference = initial;
+    for (int t = 0; t < steps; ++t) {
+        IntegrateCreaturesScalar(reference.batch());
+    }
+
+    int failures = 0;
+    std::printf("detected kernel: %s\n", KinematicsKernelToString(DetectKinematicsKernel()));
+    std::printf("%8s %12s %12s %8s\n", "kernel", "ns/creature", "max error", "result");
+    KinematicsKernel kernels[] = {KinematicsKernel::Scalar, KinematicsKernel::SSE, KinematicsKernel::AVX2};
+    const int kernelCount = 3;
+    const int rounds = 10;
+    Arrays runs[kernelCount];
+    double bestNs[kernelCount];
+    for (int k = 0; k < kernelCount; ++k) {
+        bestNs[k] = std::numeric_limits<double>::max();
+        if (!IsKinematicsKernelSupported(kernels[k])) continue;
+        runs[k] = initial;
+        // the first wide instructions can run slow while the core powers up its vector units,
+        // so each kernel gets a few untimed steps on a scratch copy first
+        Arrays warm = initial;
+        for (int t = 0; t < 20; ++t) IntegrateCreatures(warm.batch(), kernels[k]);
+    }
+    // rounds alternate between the kernels so a slow stretch of the machine hits all of them,
+    // each reports its best round
+    for (int r = 0; r < rounds; ++r) {
+        for (int k = 0; k < kernelCount; ++k) {
+            if (!IsKinematicsKernelSupported(kernels[k])) continue;
+            auto start = BenchClock::now();
+            for (int t = 0; t < steps / rounds; ++t) {
+                IntegrateCreatures(runs[k].batch(), kernels[k]);
+            }
+            bestNs[k] = std::min(bestNs[k], elapsedNs(start) / ((double)(steps / rounds) * n));
+        }
+    }
+
+    KinematicsKernel fastest = KinematicsKernel::Scalar;
+    double fastestNs = std::numeric_limits<double>::max();
+    for (int k = 0; k < kernelCount; ++k) {
+        if (!IsKinematicsKernelSupported(kernels[k])) {
+            std::printf("%8s %12s %12s %8s\n", KinematicsKernelToString(kernels[k]), "-", "-", "skipped");
+            continue;
+        }
+        const Arrays& run = runs[k];
+        float maxError = 0.0f;
+        bool flagsMatch = true;
+        for (int i = 0; i < n; ++i) {
+            maxError = std::max(maxError, std::fabs(run.x[i] - reference.x[i]));
+            maxError = std::max(maxError, std::fabs(run.y[i] - reference.y[i]));
+            flagsMatch = flagsMatch && run.flipped[i] == reference.flipped[i];
+        }
+        bool ok = flagsMatch && maxError <= tolerance;
+        if (!ok) ++failures;
+        if (bestNs[k] < fastestNs) {
+            fastestNs = bestNs[k];
+            fastest = kernels[k];
+        }
+        std::printf("%8s %12.3f %12g %8s\n", KinematicsKernelToString(kernels[k]), bestNs[k], maxError, ok ? "ok" : "FAILED");
+    }
+    std::printf("fastest here: %s\n", KinematicsKernelToString(fastest));
+    return failures == 0 ? 0 : 1;
+}
+
+namespace {
+
+std::shared_ptr<AquariumGameScene> makeSnapshotScene(CreatureStorage storage, int populationScale) {
+    auto scene = CreateAquariumGameScene(1024, 768, 5, 7);
+    scene->GetAquarium()->setStorage(storage);
+    scene->GetAquarium()->scaleLevelPopulations(populationScale);
+    scene->GetPlayer()->setDirection(1, 0.5f); // keep it eating so score, lives and levels move too
+    return scene;
+}
+
+void runTicks(AquariumGameScene& scene, int ticks) {
+    for (int t = 0; t < ticks; ++t) scene.Update();
+}
+
+} // namespace
+
+// The sub-millisecond save and restore target is for array storage, where the state already is
+// the packed columns. Object storage has to read or write every creature object, which at this
+// size is memory bound at a few milliseconds; it is timed for comparison, not against the target.
+int RunSnapshotBenchmark() {
+    const int populationScale = 10000; // ~100k creatures, the first level has 10
+    const int reps = 20;
+    const int replayTicks = 120;
+    const double targetMs = 1.0;
+
+    int failures = 0;
+    std::printf("%8s %10s %10s %11s %11s %8s %8s %8s\n", "storage", "creatures", "bytes", "save(ms)", "restore(ms)", "rewind",
+                "fork", "<1ms");
+    CreatureStorage modes[2] = {CreatureStorage::Objects, CreatureStorage::Arrays};
+    for (CreatureStorage mode : modes) {
+        auto scene = makeSnapshotScene(mode, populationScale);
+        runTicks(*scene, 30);
+
+        // medians, a shared machine throws the odd repetition way off
+        auto median = [](std::vector<double>& ms) {
+            std::sort(ms.begin(), ms.end());
+            return ms[ms.size() / 2];
+        };
+        std::vector<double> times;
+        std::vector<uint8_t> start, ahead, replay;
+        scene->SaveSnapshot(start); // first one sizes the buffers
+        for (int r = 0; r < reps; ++r) {
+            auto t0 = BenchClock::now();
+            scene->SaveSnapshot(start);
+            times.push_back(elapsedNs(t0) / 1e6);
+        }
+        double saveMs = median(times);
+
+        runTicks(*scene, replayTicks);
+        scene->SaveSnapshot(ahead);
+
+        // rewind: back to start and play the same ticks again
+        std::string error;
+        times.clear();
+        for (int r = 0; r < reps; ++r) {
+            auto t1 = BenchClock::now();
+            scene->RestoreSnapshot(start.data(), start.size(), error);
+            times.push_back(elapsedNs(t1) / 1e6);
+        }
+        double restoreMs = median(times);
+        runTicks(*scene, replayTicks);
+        scene->SaveSnapshot(replay);
+        bool rewindOk = replay == ahead;
+
+        // fork: a brand new scene picks up from the same snapshot
+        auto fork = makeSnapshotScene(mode, 1);
+        bool forkOk = fork->RestoreSnapshot(start.data(), start.size(), error);
+        if (forkOk) {
+            runTicks(*fork, replayTicks);
+            fork->SaveSnapshot(replay);
+            forkOk = replay == ahead;
+        }
+
+        // the target is part of the check for array storage, like replaying the same run
+        bool timed = mode == CreatureStorage::Arrays;
+        bool targetOk = saveMs < targetMs && restoreMs < targetMs;
+        if (!rewindOk || !forkOk || (timed && !targetOk)) ++failures;
+        const char* target = !timed ? "n/a" : targetOk ? "ok" : "FAILED";
+        std::printf("%8s %10d %10zu %11.3f %11.3f %8s %8s %8s\n", mode == CreatureStorage::Arrays ? "arrays" : "objects",
+                    scene->GetAquarium()->getCreatureCount(), start.size(), saveMs, restoreMs,
+                    rewindOk ? "ok" : "FAILED", forkOk ? "ok" : "FAILED", target);
+    }
+    std::printf("array storage has to save and restore in under 1ms (non-zero exit otherwise); object storage visits every creature object and is shown for comparison\n");
+    return failures == 0 ? 0 : 1;
+}
+
+namespace {
+
+// accumulates only the parts of a repetition the benchmark wants timed
+struct Stopwatch {
+    void start() { m_start = BenchClock::now(); }
+    void stop() { ns += elapsedNs(m_start); }
+    double ns = 0;
+private:
+    BenchClock::time_point m_start;
+};
+
+struct MicroResult {
+    std::string name;
+    int creatures = 0;
+    long long ops = 0;      // operations timed across all repetitions
+    double seconds = 0;     // timed, setup between repetitions excluded
+    double bestNsPerOp = 0; // fastest repetition
+    int repetitions = 0;
+    int itemsPerOp = 1;     // creatures one operation handles, e.g. a whole refill for Repopulate
+};
+
+// one repetition: runs `passes` rounds of the benchmark, timing what it should, and returns
+// how many operations it timed
+using MicroBody = std::function<long long(int passes, Stopwatch& timer)>;
+
+MicroResult runMicro(const std::string& name, int creatures, double minSeconds, const MicroBody& body) {
+    // more passes per repetition until one takes a millisecond, so the clock reads don't
+    // show up in the cheap kernels; doubles as the warm-up
+    int passes = 1;
+    while (passes < (1 << 20)) {
+        Stopwatch timer;
+        body(passes, timer);
+        if (timer.ns >= 1e6) break;
+        passes *= 2;
+    }
+    MicroResult result;
+    result.name = name;
+    result.creatures = creatures;
+    result.bestNsPerOp = std::numeric_limits<double>::max();
+    while (result.seconds < minSeconds || result.repetitions < 3) {
+        Stopwatch timer;
+        long long ops = body(passes, timer);
+        result.ops += ops;
+        result.seconds += timer.ns / 1e9;
+        result.bestNsPerOp = std::min(result.bestNsPerOp, timer.ns / std::max(ops, 1LL));
+        result.repetitions++;
+    }
+    return result;
+}
+
+// same density at every size as the grid benchmark, about a 1024x768 screen per 1000 fish
+void microWorldSize(int creatures, int& width, int& height) {
+    float scale = std::sqrt(creatures / 1000.0f);
+    width = std::max(64, (int)(1024 * scale));
+    height = std::max(48, (int)(768 * scale));
+}
+
+std::shared_ptr<Aquarium> makeMicroAquarium(int creatures) {
+    int width, height;
+    microWorldSize(creatures, width, height);
+    auto aquarium = std::make_shared<Aquarium>(width, height);
+    aquarium->setSeed(7);
+    aquarium->addAquariumLevel(std::make_shared<BenchLevel>(creatures));
+    aquarium->Repopulate();
+    return aquarium;
+}
+
+// n creatures of exactly T spread over a little more than the walls, so bounce() sees both sides
+template <typename T>
+std::vector<std::shared_ptr<T>> makeMicroCreatures(int creatures) {
+    int width, height;
+    microWorldSize(creatures, width, height);
+    RandomStream rng(11, 0);
+    std::vector<std::shared_ptr<T>> out;
+    out.reserve(creatures);
+    for (int i = 0; i < creatures; ++i) {
+        float x = rng.nextFloat() * width * 1.2f - width * 0.1f;
+        float y = rng.nextFloat() * height * 1.2f - height * 0.1f;
+        auto creature = std::make_shared<T>(x, y, 1 + rng.nextInt(25), NO_SPRITE, RandomStream::Substream(11, i));
+        creature->setBounds(width, height);
+        out.push_back(std::move(creature));
+    }
+    return out;
+}
+
+template <typename T>
+MicroResult microMove(const char* name, int n, double minSeconds) {
+    auto creatures = makeMicroCreatures<T>(n);
+    // the same statically bound call the aquarium's per-type groups make
+    return runMicro(name, n, minSeconds, [&](int passes, Stopwatch& timer) {
+        timer.start();
+        for (int p = 0; p < passes; ++p) {
+            for (auto& creature : creatures) MoveExact(creature.get());
+        }
+        timer.stop();
+        return (long long)passes * n;
+    });
+}
+
+void writeMicroJson(std::FILE* out, const std::vector<MicroResult>& results) {
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"suite\": \"aquarium-micro\",\n");
+    std::fprintf(out, "  \"version\": 1,\n");
+    std::fprintf(out, "  \"timestamp\": %lld,\n", (long long)std::time(nullptr));
+#ifdef __VERSION__
+    std::fprintf(out, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+    std::fprintf(out, "  \"kinematics_kernel\": \"%s\",\n", KinematicsKernelToString(DetectKinematicsKernel()));
+    std::fprintf(out, "  \"results\": [\n");
+    for (size_t i = 0; i < results.size(); ++i) {
+        const MicroResult& r = results[i];
+        double nsPerOp = r.seconds * 1e9 / std::max(r.ops, 1LL);
+        std::fprintf(out, "    {\"name\": \"%s\", \"creatures\": %d, \"ops\": %lld, \"repetitions\": %d, "
+                          "\"items_per_op\": %d, \"ns_per_op\": %.3f, \"best_ns_per_op\": %.3f, \"ops_per_sec\": %.1f}%s\n",
+                     r.name.c_str(), r.creatures, r.ops, r.repetitions, r.itemsPerOp, nsPerOp, r.bestNsPerOp,
+                     r.ops / std::max(r.seconds, 1e-12), i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int RunMicroBenchmarks(int argc, char* argv[]) {
+    std::vector<int> sizes = {100, 1000, 10000, 100000, 1000000};
+    std::string filter;
+    std::string outPath;
+    double minSeconds = 0.2;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--bench-micro") {
+            continue;
+        } else if (arg == "--sizes" && hasValue) {
+            sizes.clear();
+            std::stringstream list(argv[++i]);
+            std::string size;
+            while (std::getline(list, size, ',')) {
+                if (std::atoi(size.c_str()) > 0) sizes.push_back(std::atoi(size.c_str()));
+            }
+        } else if (arg == "--filter" && hasValue) {
+            filter = argv[++i];
+        } else if (arg == "--out" && hasValue) {
+            outPath = argv[++i];
+        } else if (arg == "--min-time" && hasValue) {
+            minSeconds = std::atof(argv[++i]);
+        } else {
+            std::fprintf(stderr, "unknown micro benchmark option: %s\n", arg.c_str());
+            return 2;
+        }
+    }
+    if (sizes.empty()) {
+        std::fprintf(stderr, "--sizes needs at least one positive count\n");
+        return 2;
+    }
+
+    std::vector<MicroResult> results;
+    auto wanted = [&](const char* name) { return filter.empty() || std::string(name).find(filter) != std::string::npos; };
+    auto add = [&](MicroResult result) {
+        // progress goes to stderr, stdout may be the JSON
+        std::fprintf(stderr, "%-28s %8d %12.2f ns/op\n", result.name.c_str(), result.creatures,
+                     result.seconds * 1e9 / std::max(result.ops, 1LL));
+        results.push_back(std::move(result));
+    };
+
+    for (int n : sizes) {
+        if (wanted("checkCollision")) {
+            auto creatures = makeMicroCreatures<NPCreature>(n);
+            std::shared_ptr<Creature> probe = creatures[n / 2];
+            int hits = 0;
+            add(runMicro("checkCollision", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                timer.start();
+                for (int p = 0; p < passes; ++p) {
+                    for (auto& creature : creatures) hits += checkCollision(probe, creature);
+                }
+                timer.stop();
+                return (long long)passes * n;
+            }));
+            (void)hits;
+        }
+
+        bool detectWanted = wanted("DetectAquariumCollisions");
+        bool tickWanted = wanted("DetectAquariumCollisions/tick");
+        if (detectWanted || tickWanted) {
+            // every pass is a game tick: the creatures swim (which keeps the spatial index
+            // current), whatever the tick published is drained the way the game's readers do,
+            // then the players look for contacts
+            auto aquarium = makeMicroAquarium(n);
+            auto events = std::make_unique<GameEventBus>();
+            aquarium->setEventBus(events.get());
+            GameEventBus::Reader reader = events->makeReader();
+            std::vector<CreatureHandle> contacts;
+            // players parked all over the aquarium
+            std::vector<std::shared_ptr<PlayerCreature>> players;
+            RandomStream rng(3, 0);
+            for (int i = 0; i < 256; ++i) {
+                players.push_back(std::make_shared<PlayerCreature>(rng.nextFloat() * aquarium->getWidth(),
+                                                                   rng.nextFloat() * aquarium->getHeight(), 5, NO_SPRITE));
+            }
+            auto drain = [&reader]() {
+                GameEvent event;
+                while (reader.poll(event)) {}
+            };
+            // the detection alone, one call per player after each tick's update
+            if (detectWanted) add(runMicro("DetectAquariumCollisions", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                for (int p = 0; p < passes; ++p) {
+                    aquarium->update();
+                    drain();
+                    timer.start();
+                    for (auto& player : players) DetectAquariumCollisions(aquarium, player, contacts);
+                    timer.stop();
+                }
+                return (long long)passes * (long long)players.size();
+            }));
+            // a whole tick as the game runs it, update included, with one player
+            size_t next = 0;
+            if (tickWanted) add(runMicro("DetectAquariumCollisions/tick", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                for (int p = 0; p < passes; ++p) {
+                    timer.start();
+                    aquarium->update();
+                    DetectAquariumCollisions(aquarium, players[next++ % players.size()], contacts);
+                    timer.stop();
+                    drain();
+                }
+                return (long long)passes;
+            }));
+            aquarium->setEventBus(nullptr);
+        }
+
+        if (wanted("move/NPCreature")) add(microMove<NPCreature>("move/NPCreature", n, minSeconds));
+        if (wanted("move/BiggerFish")) add(microMove<BiggerFish>("move/BiggerFish", n, minSeconds));
+        if (wanted("move/PinkFish")) add(microMove<PinkFish>("move/PinkFish", n, minSeconds));
+        if (wanted("move/SharkFish")) add(microMove<SharkFish>("move/SharkFish", n, minSeconds));
+
+        if (wanted("bounce")) {
+            auto creatures = makeMicroCreatures<NPCreature>(n);
+            add(runMicro("bounce", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                timer.start();
+                for (int p = 0; p < passes; ++p) {
+                    for (auto& creature : creatures) creature->bounce();
+                }
+                timer.stop();
+                return (long long)passes * n;
+            }));
+        }
+
+        // both remove a tenth of the population per pass; refilling it again is untimed for
+        // the removal and the whole measurement for repopulation
+        int batch = std::max(1, n / 10);
+        if (wanted("removeCreature")) {
+            auto aquarium = makeMicroAquarium(n);
+            RandomStream rng(5, 0);
+            add(runMicro("removeCreature", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                for (int p = 0; p < passes; ++p) {
+                    timer.start();
+                    for (int i = 0; i < batch; ++i) {
+                        aquarium->removeCreature(aquarium->getCreatureHandleAt(rng.nextInt(aquarium->getCreatureCount())));
+                    }
+                    timer.stop();
+                    aquarium->Repopulate();
+                }
+                return (long long)passes * batch;
+            }));
+        }
+
+        if (wanted("Repopulate")) {
+            auto aquarium = makeMicroAquarium(n);
+            RandomStream rng(5, 0);
+            MicroResult result = runMicro("Repopulate", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                for (int p = 0; p < passes; ++p) {
+                    for (int i = 0; i < batch; ++i) {
+                        aquarium->removeCreature(aquarium->getCreatureHandleAt(rng.nextInt(aquarium->getCreatureCount())));
+                    }
+                    timer.start();
+                    aquarium->Repopulate();
+                    timer.stop();
+                }
+                return (long long)passes; // one op is one refill of `batch` creatures
+            });
+            result.itemsPerOp = batch;
+            add(std::move(result));
+        }
+
+        if (wanted("ConsumePopulation")) {
+            BenchLevel level(n);
+            add(runMicro("ConsumePopulation", n, minSeconds, [&](int passes, Stopwatch& timer) {
+                timer.start();
+                for (int p = 0; p < passes; ++p) {
+                    for (int i = 0; i < n; ++i) level.ConsumePopulation((AquariumCreatureType)(i & 3), 1);
+                }
+                timer.stop();
+                level.levelReset(); // keeps the score from overflowing on long runs
+                return (long long)passes * n;
+            }));
+        }
+    }
+
+    std::FILE* out = outPath.empty() ? stdout : std::fopen(outPath.c_str(), "w");
+    if (!out) {
+        std::fprintf(stderr, "cannot write %s\n", outPath.c_str());
+        return 1;
+    }
+    writeMicroJson(out, results);
+    if (out != stdout) std::fclose(out);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+// Offline benchmarks, run from the command line instead of opening the game window
+// (see main.cpp). They print plain text results to stdout, the micro suite prints JSON.
+
+// query cost of the aquarium spatial index from 1k to 100k creatures
+int RunSpatialGridBenchmark();
+
+// ms per Aquarium::update with object storage vs array storage at 50k and 100k creatures
+int RunStorageBenchmark();
+
+// save/restore time of a full scene snapshot at ~100k creatures in both storage modes, and
+// checks that rewinding to a snapshot and forking a fresh scene from it replay the same run;
+// returns non-zero if either diverges
+int RunSnapshotBenchmark();
+
+// times each batch kinematics kernel and checks the vector ones against the scalar
+// reference, returns non-zero if any of them drifts outside the tolerance
+int RunKinematicsBenchmark();
+
+// per-kernel microbenchmarks (checkCollision, DetectAquariumCollisions, each move(), bounce,
+// removeCreature, Repopulate, ConsumePopulation) from 100 to 1M creatures, written as JSON to
+// stdout or --out FILE so results can be tracked across commits; --sizes 100,1000,...
+// --filter NAME and --min-time SECONDS (per kernel and size) narrow a run down
+int RunMicroBenchmarks(int argc, char* argv[]);
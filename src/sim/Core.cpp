@@ -0,0 +1,380 @@
+#include "Core.h"
+#include "Log.h"
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+
+// CreatureStore
+int CreatureStore::attach(Creature* creature, int typeTag) {
+    if (creature->m_store) creature->m_store->detach(creature);
+    int slot = this->size();
+    x.push_back(creature->m_x);
+    y.push_back(creature->m_y);
+    prevX.push_back(creature->m_prevX);
+    prevY.push_back(creature->m_prevY);
+    dx.push_back(creature->m_dx);
+    dy.push_back(creature->m_dy);
+    speed.push_back(creature->m_speed);
+    radius.push_back(creature->m_collisionRadius);
+    value.push_back(creature->m_value);
+    flipped.push_back(creature->m_flipped);
+    type.push_back((uint8_t)typeTag);
+    phase.push_back(0.0f);
+    dashFrames.push_back(0);
+    cooldownFrames.push_back(0);
+    rng.emplace_back();
+    sx.push_back(0.0f);
+    sy.push_back(0.0f);
+    oy.push_back(0.0f);
+    owner.push_back(creature);
+    creature->saveExtraState(*this, slot);
+    creature->m_store = this;
+    creature->m_slot = slot;
+    return slot;
+}
+
+void CreatureStore::reserve(int slots) {
+    size_t n = (size_t)slots;
+    x.reserve(n); y.reserve(n); prevX.reserve(n); prevY.reserve(n); dx.reserve(n); dy.reserve(n);
+    speed.reserve(n); radius.reserve(n); value.reserve(n); flipped.reserve(n); type.reserve(n);
+    phase.reserve(n); dashFrames.reserve(n); cooldownFrames.reserve(n); rng.reserve(n);
+    sx.reserve(n); sy.reserve(n); oy.reserve(n); owner.reserve(n);
+}
+
+void CreatureStore::detach(Creature* creature) {
+    if (creature->m_store != this) return;
+    int slot = creature->m_slot;
+    this->copyOut(slot, creature);
+    this->release(slot);
+}
+
+void CreatureStore::copyOut(int slot, Creature* creature) const {
+    creature->m_x = x[slot];
+    creature->m_y = y[slot];
+    creature->m_prevX = prevX[slot];
+    creature->m_prevY = prevY[slot];
+    creature->m_dx = dx[slot];
+    creature->m_dy = dy[slot];
+    creature->m_speed = speed[slot];
+    creature->m_collisionRadius = radius[slot];
+    creature->m_value = value[slot];
+    creature->m_flipped = flipped[slot];
+    creature->m_width = boundsW;
+    creature->m_height = boundsH;
+    creature->loadExtraState(*this, slot);
+}
+
+void CreatureStore::copyIn(int slot, const Creature* creature, int typeTag) {
+    const CreatureStore* from = creature->m_store;
+    int at = creature->m_slot;
+    if (from) {
+        x[slot] = from->x[at];
+        y[slot] = from->y[at];
+        prevX[slot] = from->prevX[at];
+        prevY[slot] = from->prevY[at];
+        dx[slot] = from->dx[at];
+        dy[slot] = from->dy[at];
+        speed[slot] = from->speed[at];
+        radius[slot] = from->radius[at];
+        value[slot] = from->value[at];
+        flipped[slot] = from->flipped[at];
+        phase[slot] = from->phase[at];
+        dashFrames[slot] = from->dashFrames[at];
+        cooldownFrames[slot] = from->cooldownFrames[at];
+        rng[slot] = from->rng[at];
+    } else {
+        x[slot] = creature->m_x;
+        y[slot] = creature->m_y;
+        prevX[slot] = creature->m_prevX;
+        prevY[slot] = creature->m_prevY;
+        dx[slot] = creature->m_dx;
+        dy[slot] = creature->m_dy;
+        speed[slot] = creature->m_speed;
+        radius[slot] = creature->m_collisionRadius;
+        value[slot] = creature->m_value;
+        flipped[slot] = creature->m_flipped;
+        // like attach, a type only writes the extra state it has, the slot may hold someone else's
+        phase[slot] = 0.0f;
+        dashFrames[slot] = 0;
+        cooldownFrames[slot] = 0;
+        creature->saveExtraState(*this, slot);
+    }
+    type[slot] = (uint8_t)typeTag;
+}
+
+void CreatureStore::bind(int slot, Creature* creature) {
+    owner[slot] = creature;
+    creature->m_store = this;
+    creature->m_slot = slot;
+}
+
+void CreatureStore::unbind(int slot) {
+    Creature* creature = owner[slot];
+    if (!creature) return;
+    creature->m_store = nullptr;
+    creature->m_slot = -1;
+    owner[slot] = nullptr;
+}
+
+// rng first so the 8 byte column stays aligned (the snapshot records ahead of it are all
+// multiples of 8, see Snapshot.h), then the 4 byte ones, then bytes; reads still go through
+// memcpy, so nothing depends on it
+template <typename Fn>
+static void ForEachPackedColumn(Fn&& fn) {
+    fn(&CreatureStore::rng);
+    fn(&CreatureStore::x); fn(&CreatureStore::y); fn(&CreatureStore::prevX); fn(&CreatureStore::prevY);
+    fn(&CreatureStore::dx); fn(&CreatureStore::dy); fn(&CreatureStore::speed); fn(&CreatureStore::radius);
+    fn(&CreatureStore::value); fn(&CreatureStore::phase); fn(&CreatureStore::dashFrames);
+    fn(&CreatureStore::cooldownFrames);
+    fn(&CreatureStore::flipped); fn(&CreatureStore::type);
+}
+
+size_t CreatureStore::PackedSize(int count) {
+    size_t bytes = 0;
+    ForEachPackedColumn([&](auto column) {
+        using T = typename std::remove_reference_t<decltype(std::declval<CreatureStore>().*column)>::value_type;
+        bytes += sizeof(T) * (size_t)count;
+    });
+    return bytes;
+}
+
+void CreatureStore::pack(uint8_t* out) const {
+    ForEachPackedColumn([&](auto column) {
+        const auto& values = this->*column;
+        size_t bytes = values.size() * sizeof(values[0]);
+        if (bytes) std::memcpy(out, values.data(), bytes);
+        out += bytes;
+    });
+}
+
+void CreatureStore::resize(int count) {
+    ForEachPackedColumn([&](auto column) { (this->*column).resize(count); });
+    sx.resize(count);
+    sy.resize(count);
+    oy.resize(count);
+    owner.resize(count, nullptr);
+}
+
+void CreatureStore::unpack(const uint8_t* in, int count) {
+    this->resize(count);
+    ForEachPackedColumn([&](auto column) {
+        auto& values = this->*column;
+        size_t bytes = (size_t)count * sizeof(values[0]);
+        if (bytes) std::memcpy(values.data(), in, bytes);
+        in += bytes;
+    });
+}
+
+void CreatureStore::release(int slot) {
+    Creature* leaving = owner[slot];
+    int last = this->size() - 1;
+    if (slot != last) {
+        x[slot] = x[last];
+        y[slot] = y[last];
+        prevX[slot] = prevX[last];
+        prevY[slot] = prevY[last];
+        dx[slot] = dx[last];
+        dy[slot] = dy[last];
+        speed[slot] = speed[last];
+        radius[slot] = radius[last];
+        value[slot] = value[last];
+        flipped[slot] = flipped[last];
+        type[slot] = type[last];
+        phase[slot] = phase[last];
+        dashFrames[slot] = dashFrames[last];
+        cooldownFrames[slot] = cooldownFrames[last];
+        rng[slot] = rng[last];
+        owner[slot] = owner[last];
+        owner[slot]->m_slot = slot;
+    }
+    x.pop_back(); y.pop_back(); prevX.pop_back(); prevY.pop_back(); dx.pop_back(); dy.pop_back();
+    speed.pop_back(); radius.pop_back(); value.pop_back();
+    flipped.pop_back(); type.pop_back();
+    phase.pop_back(); dashFrames.pop_back(); cooldownFrames.pop_back(); rng.pop_back();
+    sx.pop_back(); sy.pop_back(); oy.pop_back();
+    owner.pop_back();
+    leaving->m_store = nullptr;
+    leaving->m_slot = -1;
+}
+
+void CreatureStore::clear() {
+    while (this->size() > 0) {
+        this->detach(owner.back());
+    }
+}
+
+// Creature Inherited Base Behavior
+Creature::~Creature() {
+    if (m_store) m_store->release(m_slot);
+}
+
+void Creature::setBounds(int w, int h) { m_width = w; m_height = h; }
+void Creature::normalize() {
+    float length = std::sqrt(m_dx * m_dx + m_dy * m_dy);
+    if (length != 0) {
+        m_dx /= length;
+        m_dy /= length;
+    }
+}
+
+void Creature::bounce() {
+    // should implement boundary controls here
+    if (m_x < 0 || m_x > m_width) {
+        m_dx = -m_dx;
+    }
+    if (m_y < 0 || m_y > m_height) {
+        m_dy = -m_dy;
+    }
+    
+}
+
+
+// CreatureRegistry
+CreatureHandle CreatureRegistry::add(Creature* creature) {
+    uint32_t index;
+    if (!m_freeSlots.empty()) {
+        index = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    } else {
+        index = (uint32_t)m_slots.size();
+        m_slots.emplace_back();
+    }
+    m_slots[index].creature = creature;
+    CreatureHandle handle{index, m_slots[index].generation};
+    creature->setHandle(handle);
+    return handle;
+}
+
+void CreatureRegistry::remove(CreatureHandle handle) {
+    Creature* creature = this->resolve(handle);
+    if (!creature) return; // already gone
+    creature->setHandle(CreatureHandle());
+    m_slots[handle.index].creature = nullptr;
+    m_slots[handle.index].generation++; // invalidates every copy of the handle
+    m_freeSlots.push_back(handle.index);
+}
+
+void CreatureRegistry::reserve(int more) {
+    int fresh = more - (int)m_freeSlots.size(); // freed slots get reused first
+    if (fresh > 0) m_slots.reserve(m_slots.size() + fresh);
+}
+
+void CreatureRegistry::clear() {
+    for (uint32_t i = 0; i < m_slots.size(); ++i) {
+        if (m_slots[i].creature) this->remove(CreatureHandle{i, m_slots[i].generation});
+    }
+}
+
+void GameEvent::print(const CreatureRegistry& registry) const {
+        Creature* a = registry.resolve(creatureA);
+        Creature* b = registry.resolve(creatureB);
+
+        
+        switch (type) {
+            case GameEventType::NONE:
+                AQ_LOG_VERBOSE("No event.");
+                break;
+            case GameEventType::COLLISION:
+                if (!a || !b) { AQ_LOG_VERBOSE("Collision event with a removed creature."); break; }
+                AQ_LOG_VERBOSE("Collision event between creatures at ({}, {}) and ({}, {}).",
+                               a->getX(), a->getY(), b->getX(), b->getY());
+                break;
+            case GameEventType::CREATURE_ADDED:
+                if (!a) { AQ_LOG_VERBOSE("Creature added."); break; }
+                AQ_LOG_VERBOSE("Creature added at ({}, {}).", a->getX(), a->getY());
+                break;
+            case GameEventType::CREATURES_SPAWNED:
+                AQ_LOG_VERBOSE("{} creatures of type {} spawned.", count, creatureType);
+                break;
+            case GameEventType::CREATURE_REMOVED:
+                if (!a) { AQ_LOG_VERBOSE("Creature removed."); break; }
+                AQ_LOG_VERBOSE("Creature removed at ({}, {}).", a->getX(), a->getY());
+                break;
+            case GameEventType::GAME_OVER:
+                AQ_LOG_VERBOSE("Game Over event.");
+                break;
+            case GameEventType::NEW_LEVEL:
+                AQ_LOG_VERBOSE("New Game level");
+                break;
+            default:
+                AQ_LOG_VERBOSE("Unknown event type.");
+                break;
+        }
+        (void)a; (void)b; // only read by the verbose messages
+};
+
+// collision detection between two creatures
+bool checkCollision(std::shared_ptr<Creature> a, std::shared_ptr<Creature> b) {
+    float dx = a->getX() - b->getX();
+    float dy = a->getY() - b->getY();
+    float distanceSquared = dx * dx + dy * dy;
+    float radiusSum = a->getCollisionRadius() + b->getCollisionRadius();
+    if (distanceSquared <= radiusSum * radiusSum) {
+        return true; 
+    }
+
+    return false; 
+};
+
+
+std::string GameSceneKindToString(GameSceneKind t){
+    switch(t)
+    {
+        case GameSceneKind::GAME_INTRO: return "GAME_INTRO";
+        case GameSceneKind::AQUARIUM_GAME: return "AQUARIUM_GAME";
+        case GameSceneKind::GAME_OVER: return "GAME_OVER";
+    };
+    return "UNKNOWN_SCENE";
+};
+
+std::shared_ptr<GameScene> GameSceneManager::GetScene(std::string name){
+    if(!this->HasScenes()){return nullptr;}
+    for(std::shared_ptr<GameScene> scene : this->m_scenes){
+        if(scene->GetName() == name){
+            return scene;
+        }
+    }
+    return nullptr;
+}
+
+void GameSceneManager::Transition(std::string name){
+    if(!this->HasScenes()){return;} // no need to do anything if nothing inside
+    std::shared_ptr<GameScene> newScene = this->GetScene(name);
+    if(newScene == nullptr){return;} // i dont have the scene so time to leave
+    if(newScene->GetName() == this->m_active_scene->GetName()){return;} // another do nothing since active scene is already pulled
+    this->m_active_scene = newScene; // now we keep it since this is a valid transition
+    return;
+}
+
+void GameSceneManager::AddScene(std::shared_ptr<GameScene> newScene){
+    if(this->GetScene(newScene->GetName()) != nullptr){
+        return; // this scene already exist and shouldnt be added again
+    }
+    this->m_scenes.push_back(newScene);
+    if(m_active_scene == nullptr){
+        this->m_active_scene = newScene; // need to place in active scene as its the only one in existance right now
+    }
+    return;
+}
+
+std::shared_ptr<GameScene> GameSceneManager::GetActiveScene(){
+    return this->m_active_scene;
+}
+
+std::string GameSceneManager::GetActiveSceneName(){
+    if(this->m_active_scene == nullptr){return "";} // something to handle missing activate scenes
+    return this->m_active_scene->GetName();
+}
+
+void GameSceneManager::UpdateActiveScene(){
+    if(!this->HasScenes()){return;} // make sure we have a scene before we try to paint
+    this->m_active_scene->Update();
+
+}
+
+void GameSceneManager::DrawActiveScene(){
+    if(!this->HasScenes()){return;} // make sure we have something before Drawing it
+    this->m_active_scene->Draw();
+}
+
@@ -0,0 +1,352 @@
+#pragma once
+
+#include <iostream>
+#include <memory>
+#include <utility>
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+#include "Random.h"
+
+
+// Accumulator for running the simulation at a fixed tick rate regardless of the render rate.
+// Each frame the elapsed time goes in and the number of ticks to run comes out; whatever is
+// left over becomes the interpolation alpha for drawing. When a frame takes so long that more
+// than maxStepsPerFrame ticks are due the rest is dropped, so a slow machine runs the world a
+// bit slower instead of spiralling, and a fast one never runs a tick that is not due yet.
+class FixedTimestep {
+public:
+	FixedTimestep(double tickHz, int maxStepsPerFrame)
+	: m_step(1.0 / tickHz), m_maxSteps(maxStepsPerFrame) {}
+
+	void setTickRate(double tickHz) { m_step = 1.0 / tickHz; }
+	double getTickRate() const { return 1.0 / m_step; }
+	double getStepSeconds() const { return m_step; }
+	void setMaxStepsPerFrame(int steps) { m_maxSteps = steps; }
+
+	int advance(double frameSeconds) {
+		m_accumulator += std::max(frameSeconds, 0.0);
+		int steps = (int)(m_accumulator / m_step);
+		if (steps > m_maxSteps) {
+			m_droppedTicks += steps - m_maxSteps;
+			steps = m_maxSteps;
+			m_accumulator = 0.0; // forget the backlog instead of chasing it next frame
+		} else {
+			m_accumulator -= steps * m_step;
+		}
+		return steps;
+	}
+
+	// fraction of a tick left over, 0 = last simulated state, 1 = the next one
+	float getAlpha() const { return (float)std::min(m_accumulator / m_step, 1.0); }
+	long long getDroppedTicks() const { return m_droppedTicks; }
+
+private:
+	double m_step;
+	int m_maxSteps;
+	double m_accumulator = 0.0;
+	long long m_droppedTicks = 0;
+};
+
+// What a creature looks like as far as the simulation cares: a number the renderer maps onto
+// whatever it draws with (see AquariumSpriteManager). Nothing in here ever looks it up, so the
+// simulation builds and runs without a single texture.
+using SpriteId = uint16_t;
+static const SpriteId NO_SPRITE = 0xFFFF;
+
+class Creature;
+
+// Generational reference to a creature handed out by a CreatureRegistry. The index names a
+// registry slot and the generation says which occupant of that slot it refers to, so a handle
+// to a removed creature is detected with one compare instead of keeping the creature alive.
+struct CreatureHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool isNull() const { return index == UINT32_MAX; }
+    bool operator==(const CreatureHandle& other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const CreatureHandle& other) const { return !(*this == other); }
+};
+
+// Structure-of-arrays storage for creature state. It is opt-in (see Aquarium::setStorage):
+// while a creature is attached its kinematic state lives in these parallel arrays and the
+// Creature getters/setters forward to its slot, so the rest of the game keeps using the
+// regular Creature API. Slots are packed, removing one moves the last slot into the hole.
+class CreatureStore {
+public:
+    int size() const { return (int)owner.size(); }
+    int attach(Creature* creature, int typeTag);
+    void detach(Creature* creature); // copies the state back into the object
+    void clear();
+    void reserve(int slots); // room for this many slots in total
+    void setBounds(float w, float h) { boundsW = w; boundsH = h; }
+
+    // snapshot support: the per-creature columns (not the per-tick sx/sy/oy) packed one
+    // after another, PackedSize bytes for count slots
+    static size_t PackedSize(int count);
+    // the type column comes last in a packed block
+    static const uint8_t* PackedTypes(const uint8_t* packed, int count) { return packed + PackedSize(count) - count; }
+    void pack(uint8_t* out) const;
+    // overwrites every column with count packed slots; slots that stay keep their owners,
+    // so unbind whatever shouldn't own its slot (or is past count) first
+    void unpack(const uint8_t* in, int count);
+    // count slots in every column, new ones zeroed and unbound, same rule as unpack for owners
+    void resize(int count);
+    // copies a creature's state, stored somewhere or not, into an unbound slot
+    void copyIn(int slot, const Creature* creature, int typeTag);
+    // copies a slot into a creature that isn't stored, extra state included
+    void copyOut(int slot, Creature* creature) const;
+    // makes creature (not stored anywhere) the owner of an unbound slot
+    void bind(int slot, Creature* creature);
+    // the slot's owner lets go without getting its state back, for when the columns get replaced
+    void unbind(int slot);
+
+    float boundsW = 0.0f;
+    float boundsH = 0.0f;
+
+    // hot state, one entry per slot
+    std::vector<float> x;
+    std::vector<float> y;
+    std::vector<float> prevX; // positions before the last step, for interpolated drawing
+    std::vector<float> prevY;
+    std::vector<float> dx;
+    std::vector<float> dy;
+    std::vector<int> speed;
+    std::vector<float> radius;
+    std::vector<int> value;
+    std::vector<uint8_t> flipped;
+    std::vector<uint8_t> type;
+
+    // per-type behaviour state (PinkFish wave phase, SharkFish dash timers, creature random stream)
+    std::vector<float> phase;
+    std::vector<int> dashFrames;
+    std::vector<int> cooldownFrames;
+    std::vector<RandomStream> rng;
+
+    // per-tick velocity terms filled by the behaviour pass: x += dx*sx, y += dy*sy + oy
+    std::vector<float> sx;
+    std::vector<float> sy;
+    std::vector<float> oy;
+
+    std::vector<Creature*> owner;
+
+private:
+    friend class Creature;
+    void release(int slot); // swap-and-pop without copying anything back
+};
+
+class Creature {
+protected:
+    Creature(float x, float y, int speed, float collisionRadius, int value,
+             SpriteId sprite)
+    : m_x(x)
+    , m_y(y)
+    , m_prevX(x)
+    , m_prevY(y)
+    , m_dx(0)
+    , m_dy(0)
+    , m_speed(speed)
+    , m_width(0)
+    , m_height(0)
+    , m_collisionRadius(collisionRadius)
+    , m_value(value)
+    , m_sprite(sprite) {}
+
+    float m_x = 0.0f;
+    float m_y = 0.0f;
+    float m_prevX = 0.0f; // position before the last simulation step, for interpolated drawing
+    float m_prevY = 0.0f;
+    float m_dx = 0.0f;
+    float m_dy = 0.0f;
+    int m_speed = 0;
+    float m_width = 0.0f;
+    float m_height = 0.0f;
+    float m_collisionRadius = 0.0f;
+    int m_value = 0;
+    SpriteId m_sprite = NO_SPRITE;
+    bool m_flipped = false;
+
+    // set while the state lives in a CreatureStore
+    CreatureStore* m_store = nullptr;
+    int m_slot = -1;
+
+    int m_aquariumIndex = -1; // position in the owning Aquarium's creature list
+    int m_groupIndex = -1;    // position in its type's list, see CreatureGroups
+    CreatureHandle m_handle;  // set while registered with a CreatureRegistry
+
+    // subclasses with extra behaviour state copy it in and out of the store
+    virtual void saveExtraState(CreatureStore&, int) const {}
+    virtual void loadExtraState(const CreatureStore&, int) {}
+
+    friend class CreatureStore;
+
+public:
+    virtual ~Creature();
+    virtual void move() = 0;
+
+    virtual float getCollisionRadius() const { return m_store ? m_store->radius[m_slot] : m_collisionRadius; }
+    virtual void setCollisionRadius(float radius) {
+        if (m_store) m_store->radius[m_slot] = radius;
+        else m_collisionRadius = radius;
+    }
+
+    float getX() const { return m_store ? m_store->x[m_slot] : m_x; }
+    float getY() const { return m_store ? m_store->y[m_slot] : m_y; }
+    int getSpeed() const { return m_store ? m_store->speed[m_slot] : m_speed; }
+    void setSpeed(int speed) {
+        if (m_store) m_store->speed[m_slot] = speed;
+        else m_speed = speed;
+    }
+    bool isFlipped() const { return m_store ? m_store->flipped[m_slot] != 0 : m_flipped; }
+    void setFlipped(bool flipped) {
+        if (m_store) m_store->flipped[m_slot] = flipped;
+        else m_flipped = flipped;
+    }
+    SpriteId getSprite() const { return m_sprite; }
+    void setSprite(SpriteId sprite) { m_sprite = sprite; }
+    int getValue() const { return m_store ? m_store->value[m_slot] : m_value; }
+    bool isStored() const { return m_store != nullptr; }
+    // maintained by the Aquarium so it can remove a creature without searching for it
+    int getAquariumIndex() const { return m_aquariumIndex; }
+    void setAquariumIndex(int index) { m_aquariumIndex = index; }
+    int getGroupIndex() const { return m_groupIndex; }
+    void setGroupIndex(int index) { m_groupIndex = index; }
+    CreatureHandle getHandle() const { return m_handle; }
+    void setHandle(CreatureHandle handle) { m_handle = handle; }
+
+    void savePreviousPosition() { m_prevX = m_x; m_prevY = m_y; }
+    // alpha blends the drawn position between the previous step (0) and the current one (1)
+    float getRenderX(float alpha) const {
+        return m_store ? m_store->prevX[m_slot] + (m_store->x[m_slot] - m_store->prevX[m_slot]) * alpha
+                       : m_prevX + (m_x - m_prevX) * alpha;
+    }
+    float getRenderY(float alpha) const {
+        return m_store ? m_store->prevY[m_slot] + (m_store->y[m_slot] - m_store->prevY[m_slot]) * alpha
+                       : m_prevY + (m_y - m_prevY) * alpha;
+    }
+
+    void setBounds(int w, int h);
+    void normalize();
+    void bounce();
+};
+
+// GameEvents
+enum class GameEventType {
+    NONE,
+    COLLISION,
+    CREATURE_ADDED,
+    CREATURES_SPAWNED, // one per spawn batch, see GameEvent::count
+    CREATURE_REMOVED,
+    GAME_OVER,
+    GAME_EXIT,
+    NEW_LEVEL,
+};
+
+// Slot map from CreatureHandle to creature. Removing a creature bumps its slot's generation so
+// every outstanding handle to it resolves to nullptr; freed slots are reused.
+class CreatureRegistry {
+public:
+    CreatureHandle add(Creature* creature);
+    void remove(CreatureHandle handle);
+    void clear();
+    void reserve(int more); // room for this many more live creatures without growing
+    Creature* resolve(CreatureHandle handle) const {
+        if (handle.index >= m_slots.size()) return nullptr;
+        const Slot& slot = m_slots[handle.index];
+        return slot.generation == handle.generation ? slot.creature : nullptr;
+    }
+    bool isAlive(CreatureHandle handle) const { return this->resolve(handle) != nullptr; }
+
+private:
+    struct Slot {
+        Creature* creature = nullptr;
+        uint32_t generation = 0;
+    };
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+};
+
+// events are plain values: handles instead of owning pointers, resolve them through the registry
+class GameEvent {
+    public:
+    GameEventType type = GameEventType::NONE;
+    CreatureHandle creatureA;
+    CreatureHandle creatureB; // For collision events
+    int creatureType = -1;    // CREATURES_SPAWNED: the AquariumCreatureType and how many
+    int count = 0;
+    GameEvent() = default;
+    GameEvent(GameEventType t, CreatureHandle a, CreatureHandle b) : type(t), creatureA(a), creatureB(b) {}
+    
+    // Additional methods can be added here
+    bool isCollisionEvent() const { return type == GameEventType::COLLISION; }
+    bool isCreatureAddedEvent() const { return type == GameEventType::CREATURE_ADDED; }
+    bool isCreaturesSpawnedEvent() const { return type == GameEventType::CREATURES_SPAWNED; }
+    bool isCreatureRemovedEvent() const { return type == GameEventType::CREATURE_REMOVED; }
+    bool isGameOver() const { return type == GameEventType::GAME_OVER; }
+    bool isGameExit() const { return type == GameEventType::GAME_EXIT; }
+    bool isNoneEvent() const { return type == GameEventType::NONE; }
+    
+    // i want a printable representation of the event, with the creature descriptions if available
+    void print(const CreatureRegistry& registry) const;
+};
+static_assert(std::is_trivially_copyable<GameEvent>::value, "events are copied around by value");
+
+
+
+
+bool checkCollision(std::shared_ptr<Creature> a, std::shared_ptr<Creature> b);
+
+
+class GameLevel {
+public:
+    GameLevel(int levelNumber) : m_levelNumber(levelNumber) {}
+    virtual ~GameLevel() = default;
+    int getLevelNumber() const { return m_levelNumber; }
+    virtual bool isCompleted() = 0;
+
+protected:
+    int m_levelNumber;
+    
+};
+
+
+
+
+class GameScene {
+    public:
+        virtual std::string GetName() = 0;
+        virtual void Update() = 0;
+        virtual void Draw() = 0;
+        virtual ~GameScene() = default;
+
+};
+
+enum class GameSceneKind {
+    GAME_INTRO,
+    AQUARIUM_GAME,
+    GAME_OVER
+};
+
+std::string GameSceneKindToString(GameSceneKind t);
+
+class GameSceneManager {
+    public:
+        void Transition(std::string name);
+        void AddScene(std::shared_ptr<GameScene> newScene);
+        bool HasScenes(){return m_scenes.size() > 0; }
+        std::shared_ptr<GameScene> GetScene(std::string name);
+        std::shared_ptr<GameScene> GetActiveScene();
+        
+        // support the functionality
+        std::string GetActiveSceneName();
+        void UpdateActiveScene();
+        void DrawActiveScene();
+
+    private:
+        std::vector<std::shared_ptr<GameScene>> m_scenes;
+        std::shared_ptr<GameScene> m_active_scene;
+
+};
\ No newline at end of file
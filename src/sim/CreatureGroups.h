@@ -0,0 +1,82 @@
+#pragma once
+
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "Core.h"
+
+// Creatures sorted into one array per concrete class. A loop over a group knows the exact
+// type at compile time, so move() can be called non-virtually (and inlined)
+// instead of going through the vtable once per creature. Types lists the classes in tag
+// order, a tag is just the index into Types; a new creature type only has to be appended.
+// Membership is by raw pointer, whoever adds a creature keeps it alive until it is removed.
+template <typename... Types>
+class CreatureGroups {
+public:
+    static constexpr int kCount = sizeof...(Types);
+
+    // the creature has to really be a Types[tag], nothing checks
+    void add(int tag, Creature* creature) {
+        this->withGroup(tag, [creature](auto& group) {
+            using T = std::remove_pointer_t<typename std::decay_t<decltype(group)>::value_type>;
+            creature->setGroupIndex((int)group.size());
+            group.push_back(static_cast<T*>(creature));
+        });
+    }
+
+    // swap-and-pop using the index the creature carries, O(1)
+    void remove(int tag, Creature* creature) {
+        this->withGroup(tag, [creature](auto& group) {
+            int index = creature->getGroupIndex();
+            if (index < 0 || index >= (int)group.size() || group[index] != creature) return;
+            group[index] = group.back();
+            group[index]->setGroupIndex(index);
+            group.pop_back();
+            creature->setGroupIndex(-1);
+        });
+    }
+
+    void clear() {
+        this->forEachGroup([](int, auto& group) {
+            for (auto* creature : group) creature->setGroupIndex(-1);
+            group.clear(); // keeps the capacity for the next level
+        });
+    }
+
+    void reserve(int tag, int count) {
+        this->withGroup(tag, [count](auto& group) { group.reserve(count); });
+    }
+
+    int size(int tag) const {
+        int count = 0;
+        this->withGroup(tag, [&count](const auto& group) { count = (int)group.size(); });
+        return count;
+    }
+
+    // fn(tag, std::vector<T*>&) once per type, in tag order
+    template <typename Fn> void forEachGroup(Fn&& fn) { forEachGroupImpl(fn, std::index_sequence_for<Types...>()); }
+    template <typename Fn> void forEachGroup(Fn&& fn) const { forEachGroupImpl(fn, std::index_sequence_for<Types...>()); }
+
+    template <int Tag> auto& get() { return std::get<Tag>(m_groups); }
+    template <int Tag> const auto& get() const { return std::get<Tag>(m_groups); }
+
+private:
+    template <typename Fn> void withGroup(int tag, Fn&& fn) {
+        this->forEachGroup([&](int t, auto& group) { if (t == tag) fn(group); });
+    }
+    template <typename Fn> void withGroup(int tag, Fn&& fn) const {
+        this->forEachGroup([&](int t, const auto& group) { if (t == tag) fn(group); });
+    }
+    template <typename Fn, size_t... I> void forEachGroupImpl(Fn& fn, std::index_sequence<I...>) {
+        (fn((int)I, std::get<I>(m_groups)), ...);
+    }
+    template <typename Fn, size_t... I> void forEachGroupImpl(Fn& fn, std::index_sequence<I...>) const {
+        (fn((int)I, std::get<I>(m_groups)), ...);
+    }
+
+    std::tuple<std::vector<Types*>...> m_groups;
+};
+
+// T's own move(), qualified so the call is bound at compile time
+template <typename T> inline void MoveExact(T* creature) { creature->T::move(); }
@@ -0,0 +1,46 @@
+#include "CreaturePool.h"
+#include <algorithm>
+
+
+static std::size_t roundToAlignment(std::size_t bytes) {
+    const std::size_t align = alignof(std::max_align_t);
+    return (bytes + align - 1) / align * align;
+}
+
+void* BlockPool::allocate(std::size_t bytes) {
+    if (m_blockSize == 0) {
+        m_blockSize = roundToAlignment(std::max(bytes, sizeof(FreeBlock)));
+    }
+    if (roundToAlignment(bytes) != m_blockSize) {
+        return ::operator new(bytes);
+    }
+    if (!m_free) this->addSlab();
+    FreeBlock* block = m_free;
+    m_free = block->next;
+    ++m_live;
+    return block;
+}
+
+void BlockPool::deallocate(void* block, std::size_t bytes) {
+    if (!block) return;
+    if (roundToAlignment(bytes) != m_blockSize) {
+        ::operator delete(block);
+        return;
+    }
+    FreeBlock* freed = static_cast<FreeBlock*>(block);
+    freed->next = m_free;
+    m_free = freed;
+    --m_live;
+}
+
+void BlockPool::addSlab() {
+    // new[] of unsigned char is aligned for any fundamental type, and blocks are a multiple of that
+    m_slabs.emplace_back(new unsigned char[m_blockSize * m_blocksPerSlab]);
+    unsigned char* slab = m_slabs.back().get();
+    // thread the new blocks onto the free list back to front so they are handed out in address order
+    for (int i = m_blocksPerSlab - 1; i >= 0; --i) {
+        FreeBlock* block = reinterpret_cast<FreeBlock*>(slab + i * m_blockSize);
+        block->next = m_free;
+        m_free = block;
+    }
+}
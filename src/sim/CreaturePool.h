@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// Fixed-size block allocator: blocks are carved out of slabs and recycled through a
+// free list, so once a pool has grown to the peak population, spawning and freeing
+// creatures no longer touches the heap. Not thread safe, spawns and removals happen
+// on the main thread.
+class BlockPool {
+public:
+    explicit BlockPool(int blocksPerSlab = 256) : m_blocksPerSlab(blocksPerSlab) {}
+    BlockPool(const BlockPool&) = delete;
+    BlockPool& operator=(const BlockPool&) = delete;
+
+    // the first request fixes the block size, other sizes go to the regular heap
+    void* allocate(std::size_t bytes);
+    void deallocate(void* block, std::size_t bytes);
+
+    std::size_t getBlockSize() const { return m_blockSize; }
+    int getSlabCount() const { return (int)m_slabs.size(); }
+    int getLiveBlocks() const { return m_live; }
+    int getCapacity() const { return (int)m_slabs.size() * m_blocksPerSlab; }
+
+private:
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+    void addSlab();
+
+    int m_blocksPerSlab;
+    std::size_t m_blockSize = 0;
+    FreeBlock* m_free = nullptr;
+    int m_live = 0;
+    std::vector<std::unique_ptr<unsigned char[]>> m_slabs;
+};
+
+// Standard allocator over a shared BlockPool, meant for std::allocate_shared so the
+// object and its control block come out of one pooled block. Every copy shares the
+// pool, which stays alive until the last pooled object is gone.
+template <typename T>
+class PoolAllocator {
+public:
+    using value_type = T;
+
+    explicit PoolAllocator(std::shared_ptr<BlockPool> pool) : m_pool(std::move(pool)) {}
+    template <typename U>
+    PoolAllocator(const PoolAllocator<U>& other) : m_pool(other.getPool()) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(m_pool->allocate(n * sizeof(T))); }
+    void deallocate(T* p, std::size_t n) { m_pool->deallocate(p, n * sizeof(T)); }
+
+    const std::shared_ptr<BlockPool>& getPool() const { return m_pool; }
+
+    template <typename U>
+    bool operator==(const PoolAllocator<U>& other) const { return m_pool == other.getPool(); }
+    template <typename U>
+    bool operator!=(const PoolAllocator<U>& other) const { return m_pool != other.getPool(); }
+
+private:
+    std::shared_ptr<BlockPool> m_pool;
+};
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Fixed size broadcast ring: one thread publishes, any number of readers each walk it at
+// their own pace with their own cursor. Nothing is allocated after construction and the
+// publisher never waits; a reader that falls more than Capacity events behind skips ahead
+// to the oldest event still in the ring and counts what it missed.
+template <typename T, size_t Capacity>
+class EventRing {
+    static_assert((Capacity & (Capacity - 1)) == 0, "capacity must be a power of two");
+    // readers copy a slot and then check it wasn't overwritten meanwhile, a torn copy
+    // of a plain struct is harmless since it gets thrown away
+    static_assert(std::is_trivially_copyable<T>::value, "events are copied without locking");
+
+public:
+    class Reader {
+    public:
+        Reader() = default;
+        explicit Reader(const EventRing& ring) : m_ring(&ring), m_cursor(ring.getPublished()) {}
+
+        // copies the next unread event into out, false once caught up
+        bool poll(T& out) {
+            if (!m_ring) return false;
+            while (true) {
+                uint64_t head = m_ring->m_head.load(std::memory_order_acquire);
+                if (m_cursor == head) return false;
+                // the oldest slot may be the one being rewritten right now, so a full ring
+                // only holds Capacity - 1 readable events
+                if (head - m_cursor >= Capacity) {
+                    m_dropped += head - (Capacity - 1) - m_cursor;
+                    m_cursor = head - (Capacity - 1);
+                }
+                out = m_ring->m_slots[m_cursor & (Capacity - 1)];
+                // the publisher starts overwriting our slot once it has Capacity events on us
+                uint64_t after = m_ring->m_head.load(std::memory_order_acquire);
+                if (after - m_cursor >= Capacity) continue;
+                ++m_cursor;
+                return true;
+            }
+        }
+
+        uint64_t getDropped() const { return m_dropped; }
+
+    private:
+        const EventRing* m_ring = nullptr;
+        uint64_t m_cursor = 0;
+        uint64_t m_dropped = 0;
+    };
+
+    EventRing() = default;
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+
+    // single producer only
+    void publish(const T& event) {
+        uint64_t head = m_head.load(std::memory_order_relaxed);
+        m_slots[head & (Capacity - 1)] = event;
+        m_head.store(head + 1, std::memory_order_release);
+    }
+
+    // a reader starting after everything published so far
+    Reader makeReader() const { return Reader(*this); }
+    uint64_t getPublished() const { return m_head.load(std::memory_order_acquire); }
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    T m_slots[Capacity];
+    std::atomic<uint64_t> m_head{0};
+};
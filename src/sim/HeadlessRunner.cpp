@@ -0,0 +1,178 @@
+#include "HeadlessRunner.h"
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "Log.h"
+#include "LevelPack.h"
+#include "Replay.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+
+bool ParseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--headless") {
+            continue;
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::atoi(argv[++i]);
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--tick-hz" && hasValue) {
+            options.tickHz = std::atof(argv[++i]);
+        } else if (arg == "--storage" && hasValue) {
+            std::string value = argv[++i];
+            if (value == "objects") options.storage = CreatureStorage::Objects;
+            else if (value == "arrays") options.storage = CreatureStorage::Arrays;
+            else return false;
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::atoi(argv[++i]);
+        } else if (arg == "--population-scale" && hasValue) {
+            options.populationScale = std::atoi(argv[++i]);
+        } else if (arg == "--trace" && hasValue) {
+            options.tracePath = argv[++i];
+        } else if (arg == "--levels" && hasValue) {
+            options.levelsPath = argv[++i];
+        } else if (arg == "--replay" && hasValue) {
+            options.replayPath = argv[++i];
+        } else if (arg == "--record" && hasValue) {
+            options.recordPath = argv[++i];
+        } else if (arg == "--no-verify") {
+            options.verifyReplay = false;
+        } else if (arg == "--stop-on-game-over") {
+            options.stopOnGameOver = true;
+        } else {
+            std::fprintf(stderr, "unknown headless option: %s\n", arg.c_str());
+            return false;
+        }
+    }
+    return options.ticks > 0 && options.threads > 0 && options.populationScale > 0 && options.tickHz > 0;
+}
+
+HeadlessResult RunHeadlessSimulation(const HeadlessOptions& options, std::shared_ptr<AquariumGameScene>* sceneOut) {
+    HeadlessResult result;
+    // zones cost a couple of clock reads each, keep them out of plain throughput runs
+    Profiler::SetEnabled(!options.tracePath.empty());
+    Profiler::SetThreadName("main");
+    LevelPack levels;
+    if (!options.levelsPath.empty() && !levels.open(options.levelsPath, result.error)) {
+        return result;
+    }
+    // no renderer means nothing gets loaded from disk or uploaded to a GPU
+    auto scene = CreateAquariumGameScene(options.width, options.height, options.playerSpeed, options.seed, &levels, options.tickHz);
+    scene->GetAquarium()->setStorage(options.storage);
+    scene->GetAquarium()->setThreadCount(options.threads);
+    if (options.populationScale > 1) {
+        scene->GetAquarium()->scaleLevelPopulations(options.populationScale); // the first step fills the rest in
+    }
+    scene->SetCollectTimings(true);
+    GameEventBus::Reader events = scene->GetEvents().makeReader();
+
+    auto start = std::chrono::steady_clock::now();
+    for (int tick = 0; tick < options.ticks; ++tick) {
+        scene->Update();
+        result.ticksRun++;
+        bool gameOver = false;
+        GameEvent event;
+        while (events.poll(event)) {
+            result.eventCounts[(int)event.type]++;
+            if (event.isCreaturesSpawnedEvent()) result.creaturesSpawned += event.count;
+            gameOver = gameOver || event.isGameOver();
+        }
+        if (result.gameOverTick < 0 && gameOver) {
+            result.gameOverTick = tick;
+            if (options.stopOnGameOver) break;
+        }
+    }
+    result.eventsDropped = events.getDropped();
+    AsyncLog::Flush(); // keep the game's messages ahead of the report
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    result.timings = scene->GetTimings();
+
+    if (sceneOut) *sceneOut = scene;
+    return result;
+}
+
+int RunHeadless(const HeadlessOptions& options) {
+    std::shared_ptr<AquariumGameScene> scene;
+    HeadlessResult result = RunHeadlessSimulation(options, &scene);
+    if (!scene) {
+        std::fprintf(stderr, "%s: %s\n", options.levelsPath.c_str(), result.error.c_str());
+        return 1;
+    }
+    const AquariumSceneTimings& t = result.timings;
+    auto player = scene->GetPlayer();
+    auto aquarium = scene->GetAquarium();
+
+    std::printf("headless run: %d ticks, seed %llu, %s storage, %d thread(s), population x%d\n", result.ticksRun,
+                (unsigned long long)options.seed, options.storage == CreatureStorage::Arrays ? "arrays" : "objects",
+                options.threads, options.populationScale);
+    std::printf("  wall time     %.3f s\n", result.seconds);
+    std::printf("  ticks/sec     %.0f\n", result.ticksRun / std::max(result.seconds, 1e-9));
+    std::printf("phase time (us per tick)\n");
+    std::printf("  player        %.3f\n", t.playerUs / std::max(t.ticks, 1));
+    std::printf("  power-ups     %.3f\n", t.powerUpUs / std::max(t.ticks, 1));
+    std::printf("  collisions    %.3f\n", t.collisionUs / std::max(t.ticks, 1));
+    std::printf("  aquarium      %.3f\n", t.aquariumUs / std::max(t.ticks, 1));
+    std::printf("final state\n");
+    std::printf("  level         %d\n", aquarium->getCurrentLevel());
+    std::printf("  creatures     %d\n", aquarium->getCreatureCount());
+    std::printf("  power-ups     %d\n", aquarium->getPowerUpCount());
+    std::printf("  score         %d\n", player->getScore());
+    std::printf("  power         %d\n", player->getPower());
+    std::printf("  lives         %d\n", player->getLives());
+    if (result.gameOverTick >= 0) {
+        std::printf("  game over at  tick %d\n", result.gameOverTick);
+    }
+    const int* counts = result.eventCounts;
+    std::printf("events\n");
+    std::printf("  collisions    %d\n", counts[(int)GameEventType::COLLISION]);
+    std::printf("  added         %d\n", counts[(int)GameEventType::CREATURE_ADDED] + result.creaturesSpawned);
+    std::printf("  spawn batches %d\n", counts[(int)GameEventType::CREATURES_SPAWNED]);
+    std::printf("  removed       %d\n", counts[(int)GameEventType::CREATURE_REMOVED]);
+    std::printf("  new levels    %d\n", counts[(int)GameEventType::NEW_LEVEL]);
+    std::printf("  game over     %d\n", counts[(int)GameEventType::GAME_OVER]);
+    std::printf("  dropped       %llu\n", (unsigned long long)result.eventsDropped);
+    if (!options.tracePath.empty()) {
+        if (!Profiler::WriteChromeTrace(options.tracePath)) {
+            std::fprintf(stderr, "could not write trace to %s\n", options.tracePath.c_str());
+            return 1;
+        }
+        std::fprintf(stderr, "trace: %d zones written to %s\n", Profiler::GetZoneCount(), options.tracePath.c_str());
+    }
+    return 0;
+}
+
+bool RunCommandLineTool(int argc, char* argv[], int& exitCode) {
+    // the tools print their own reports, gameplay notices would only bury them (and cost
+    // time in the measured loops); the game sets its own level in ofApp::setup
+    AsyncLog::SetLevel(LogLevel::Warning);
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--bench-grid") exitCode = RunSpatialGridBenchmark();
+        else if (arg == "--bench-storage") exitCode = RunStorageBenchmark();
+        else if (arg == "--bench-kinematics") exitCode = RunKinematicsBenchmark();
+        else if (arg == "--bench-snapshot") exitCode = RunSnapshotBenchmark();
+        else if (arg == "--bench-micro") exitCode = RunMicroBenchmarks(argc, argv);
+        else if (arg == "--compile-levels") {
+            if (i + 2 >= argc) {
+                std::fprintf(stderr, "usage: --compile-levels levels.txt levels.aqlp\n");
+                exitCode = 2;
+            } else {
+                exitCode = RunLevelPackCompiler(argv[i + 1], argv[i + 2]);
+            }
+        } else if (arg == "--headless") {
+            HeadlessOptions options;
+            if (!ParseHeadlessOptions(argc, argv, options)) exitCode = 2;
+            else if (!options.replayPath.empty()) exitCode = RunReplay(options);
+            else if (!options.recordPath.empty()) exitCode = RunRecordedSession(options);
+            else exitCode = RunHeadless(options);
+        } else {
+            continue;
+        }
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include "Aquarium.h"
+
+// Runs the aquarium game scene without a window: no renderer, no textures, no frame cap.
+// Builds the same aquarium and levels as ofApp::setup and calls the scene's Update
+// once per tick, as fast as possible, then prints throughput, per-phase time and the
+// final state. Meant for CI and build machines without a GPU.
+struct HeadlessOptions {
+    int ticks = 10000;
+    int width = 1024;   // same window size as main.cpp
+    int height = 768;
+    int playerSpeed = 5;
+    double tickHz = kAquariumDesignTickHz; // the rate the run stands in for, it still runs flat out
+    uint64_t seed = 1;
+    bool stopOnGameOver = false; // the app leaves the scene on game over, the benchmark keeps going by default
+    CreatureStorage storage = CreatureStorage::Objects;
+    int threads = 1;
+    int populationScale = 1; // multiplies every level's population, e.g. 10000 for ~100k fish on the first level
+    std::string tracePath;   // when set, profiler zones are written there as a Chrome trace
+    std::string levelsPath;  // compiled level pack, the built-in levels when empty
+    std::string replayPath;  // recorded session to play back instead, see Replay.h
+    std::string recordPath;  // record a scripted session there and play it back, see Replay.h
+    bool verifyReplay = true;
+};
+
+struct HeadlessResult {
+    int ticksRun = 0;
+    double seconds = 0;
+    int gameOverTick = -1;
+    AquariumSceneTimings timings;
+    int eventCounts[(int)GameEventType::NEW_LEVEL + 1] = {}; // by GameEventType
+    int creaturesSpawned = 0;   // summed over the CREATURES_SPAWNED batches
+    uint64_t eventsDropped = 0; // overran the ring between two drains
+    std::string error;          // set when the run could not start, e.g. a bad level pack
+};
+
+// parses --ticks N, --seed N, --tick-hz N, --storage objects|arrays, --threads N,
+// --population-scale N, --trace FILE, --levels FILE, --stop-on-game-over, --replay FILE, --record FILE
+// and --no-verify;
+// returns false on an unknown or malformed argument
+bool ParseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options);
+
+HeadlessResult RunHeadlessSimulation(const HeadlessOptions& options, std::shared_ptr<AquariumGameScene>* sceneOut = nullptr);
+
+// runs the simulation and prints the report, returns the process exit code
+int RunHeadless(const HeadlessOptions& options);
+
+// the modes that run without a window (--headless, --bench-*, --compile-levels), shared by the
+// game's main and the standalone build in headless.make; false when argv asks for none of
+// them, otherwise exitCode is what the process should return
+bool RunCommandLineTool(int argc, char* argv[], int& exitCode);
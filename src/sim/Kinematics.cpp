@@ -0,0 +1,137 @@
+#include "Kinematics.h"
+
+// the vector kernels are only built for x86 with GCC/Clang, everything else falls back to scalar
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define AQUARIUM_KINEMATICS_X86 1
+#include <immintrin.h>
+#else
+#define AQUARIUM_KINEMATICS_X86 0
+#endif
+
+
+const char* KinematicsKernelToString(KinematicsKernel k) {
+    switch (k) {
+        case KinematicsKernel::SSE: return "sse";
+        case KinematicsKernel::AVX2: return "avx2";
+        default: return "scalar";
+    }
+}
+
+bool IsKinematicsKernelSupported(KinematicsKernel k) {
+    switch (k) {
+#if AQUARIUM_KINEMATICS_X86
+        case KinematicsKernel::SSE: return __builtin_cpu_supports("sse2");
+        case KinematicsKernel::AVX2: return __builtin_cpu_supports("avx2");
+#endif
+        case KinematicsKernel::Scalar: return true;
+        default: return false;
+    }
+}
+
+KinematicsKernel DetectKinematicsKernel() {
+    static const KinematicsKernel detected = [] {
+        if (IsKinematicsKernelSupported(KinematicsKernel::AVX2)) return KinematicsKernel::AVX2;
+        if (IsKinematicsKernelSupported(KinematicsKernel::SSE)) return KinematicsKernel::SSE;
+        return KinematicsKernel::Scalar;
+    }();
+    return detected;
+}
+
+// integrates the range [begin, end), also used for the tails of the vector kernels
+static void integrateRange(const KinematicsBatch& b, int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+        b.flipped[i] = b.dx[i] < 0;
+        b.x[i] += b.dx[i] * b.sx[i];
+        b.y[i] += b.dy[i] * b.sy[i] + b.oy[i];
+        if (b.x[i] < 0 || b.x[i] > b.boundsW) b.dx[i] = -b.dx[i];
+        if (b.y[i] < 0 || b.y[i] > b.boundsH) b.dy[i] = -b.dy[i];
+    }
+}
+
+void IntegrateCreaturesScalar(const KinematicsBatch& batch) {
+    integrateRange(batch, 0, batch.count);
+}
+
+#if AQUARIUM_KINEMATICS_X86
+
+__attribute__((target("sse2")))
+static void integrateSSE(const KinematicsBatch& b) {
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signBit = _mm_set1_ps(-0.0f);
+    const __m128 maxX = _mm_set1_ps(b.boundsW);
+    const __m128 maxY = _mm_set1_ps(b.boundsH);
+    int i = 0;
+    for (; i + 4 <= b.count; i += 4) {
+        __m128 x = _mm_loadu_ps(b.x + i);
+        __m128 y = _mm_loadu_ps(b.y + i);
+        __m128 dx = _mm_loadu_ps(b.dx + i);
+        __m128 dy = _mm_loadu_ps(b.dy + i);
+
+        int flipMask = _mm_movemask_ps(_mm_cmplt_ps(dx, zero));
+        for (int k = 0; k < 4; ++k) b.flipped[i + k] = (flipMask >> k) & 1;
+
+        x = _mm_add_ps(x, _mm_mul_ps(dx, _mm_loadu_ps(b.sx + i)));
+        y = _mm_add_ps(y, _mm_add_ps(_mm_mul_ps(dy, _mm_loadu_ps(b.sy + i)), _mm_loadu_ps(b.oy + i)));
+
+        // reflect by flipping the sign bit of the lanes that left the box
+        __m128 outX = _mm_or_ps(_mm_cmplt_ps(x, zero), _mm_cmpgt_ps(x, maxX));
+        __m128 outY = _mm_or_ps(_mm_cmplt_ps(y, zero), _mm_cmpgt_ps(y, maxY));
+        dx = _mm_xor_ps(dx, _mm_and_ps(outX, signBit));
+        dy = _mm_xor_ps(dy, _mm_and_ps(outY, signBit));
+
+        _mm_storeu_ps(b.x + i, x);
+        _mm_storeu_ps(b.y + i, y);
+        _mm_storeu_ps(b.dx + i, dx);
+        _mm_storeu_ps(b.dy + i, dy);
+    }
+    integrateRange(b, i, b.count);
+}
+
+__attribute__((target("avx2")))
+static void integrateAVX2(const KinematicsBatch& b) {
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signBit = _mm256_set1_ps(-0.0f);
+    const __m256 maxX = _mm256_set1_ps(b.boundsW);
+    const __m256 maxY = _mm256_set1_ps(b.boundsH);
+    int i = 0;
+    for (; i + 8 <= b.count; i += 8) {
+        __m256 x = _mm256_loadu_ps(b.x + i);
+        __m256 y = _mm256_loadu_ps(b.y + i);
+        __m256 dx = _mm256_loadu_ps(b.dx + i);
+        __m256 dy = _mm256_loadu_ps(b.dy + i);
+
+        int flipMask = _mm256_movemask_ps(_mm256_cmp_ps(dx, zero, _CMP_LT_OQ));
+        for (int k = 0; k < 8; ++k) b.flipped[i + k] = (flipMask >> k) & 1;
+
+        // mul and add kept separate (no FMA) so results match the scalar path
+        x = _mm256_add_ps(x, _mm256_mul_ps(dx, _mm256_loadu_ps(b.sx + i)));
+        y = _mm256_add_ps(y, _mm256_add_ps(_mm256_mul_ps(dy, _mm256_loadu_ps(b.sy + i)), _mm256_loadu_ps(b.oy + i)));
+
+        __m256 outX = _mm256_or_ps(_mm256_cmp_ps(x, zero, _CMP_LT_OQ), _mm256_cmp_ps(x, maxX, _CMP_GT_OQ));
+        __m256 outY = _mm256_or_ps(_mm256_cmp_ps(y, zero, _CMP_LT_OQ), _mm256_cmp_ps(y, maxY, _CMP_GT_OQ));
+        dx = _mm256_xor_ps(dx, _mm256_and_ps(outX, signBit));
+        dy = _mm256_xor_ps(dy, _mm256_and_ps(outY, signBit));
+
+        _mm256_storeu_ps(b.x + i, x);
+        _mm256_storeu_ps(b.y + i, y);
+        _mm256_storeu_ps(b.dx + i, dx);
+        _mm256_storeu_ps(b.dy + i, dy);
+    }
+    integrateRange(b, i, b.count);
+}
+
+#endif
+
+void IntegrateCreatures(const KinematicsBatch& batch, KinematicsKernel kernel) {
+    switch (kernel) {
+#if AQUARIUM_KINEMATICS_X86
+        case KinematicsKernel::AVX2: integrateAVX2(batch); return;
+        case KinematicsKernel::SSE: integrateSSE(batch); return;
+#endif
+        default: IntegrateCreaturesScalar(batch); return;
+    }
+}
+
+void IntegrateCreatures(const KinematicsBatch& batch) {
+    IntegrateCreatures(batch, DetectKinematicsKernel());
+}
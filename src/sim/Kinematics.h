@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+// Batch movement kernel for creatures kept in array storage (see CreatureStore).
+// For every i it does what the per-type move()/bounce() pair does for one creature:
+//     flipped = dx < 0
+//     x += dx * sx
+//     y += dy * sy + oy
+//     dx/dy reflect when the new position is outside [0, bounds]
+// The per-type speed terms (sx, sy, oy) are filled in beforehand by the caller.
+struct KinematicsBatch {
+    float* x;
+    float* y;
+    float* dx;
+    float* dy;
+    const float* sx;
+    const float* sy;
+    const float* oy;
+    uint8_t* flipped;
+    int count;
+    float boundsW;
+    float boundsH;
+};
+
+enum class KinematicsKernel {
+    Scalar,
+    SSE,
+    AVX2
+};
+
+const char* KinematicsKernelToString(KinematicsKernel k);
+
+// best kernel this CPU supports, detected once at runtime
+KinematicsKernel DetectKinematicsKernel();
+bool IsKinematicsKernelSupported(KinematicsKernel k);
+
+// the scalar version is the reference the vector ones are checked against
+void IntegrateCreaturesScalar(const KinematicsBatch& batch);
+void IntegrateCreatures(const KinematicsBatch& batch, KinematicsKernel kernel);
+void IntegrateCreatures(const KinematicsBatch& batch); // uses DetectKinematicsKernel()
@@ -0,0 +1,298 @@
+#include "LevelPack.h"
+#include "Aquarium.h"
+#include <cstdio>
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sstream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+LevelPack::~LevelPack() {
+    this->close();
+}
+
+void LevelPack::close() {
+#ifdef _WIN32
+    if (m_mapping) UnmapViewOfFile(m_mapping);
+    if (m_mapHandle) CloseHandle((HANDLE)m_mapHandle);
+    if (m_fileHandle) CloseHandle((HANDLE)m_fileHandle);
+    m_mapHandle = m_fileHandle = nullptr;
+#else
+    if (m_mapping) munmap(m_mapping, m_mappingSize);
+#endif
+    m_mapping = nullptr;
+    m_mappingSize = 0;
+    m_owned.clear();
+    m_header = nullptr;
+    m_levels = nullptr;
+    m_populations = nullptr;
+}
+
+bool LevelPack::open(const std::string& path, std::string& error) {
+    this->close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { error = "cannot open " + path; return false; }
+    LARGE_INTEGER size;
+    GetFileSizeEx(file, &size);
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    void* data = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+    m_fileHandle = file;
+    m_mapHandle = mapping;
+    if (!data) { error = "cannot map " + path; this->close(); return false; }
+    m_mapping = data;
+    m_mappingSize = (size_t)size.QuadPart;
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) { error = "cannot open " + path; return false; }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size == 0) { ::close(fd); error = "empty or unreadable " + path; return false; }
+    void* data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd); // the mapping keeps the file alive
+    if (data == MAP_FAILED) { error = "cannot map " + path; return false; }
+    m_mapping = data;
+    m_mappingSize = (size_t)st.st_size;
+#endif
+    if (!this->bind((const uint8_t*)m_mapping, m_mappingSize, error)) {
+        error = path + ": " + error;
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+bool LevelPack::loadBytes(std::vector<uint8_t> bytes, std::string& error) {
+    this->close();
+    m_owned = std::move(bytes);
+    if (!this->bind(m_owned.data(), m_owned.size(), error)) {
+        this->close();
+        return false;
+    }
+    return true;
+}
+
+bool LevelPack::loadBuiltin(std::string& error) {
+    std::vector<uint8_t> bytes;
+    if (!CompileLevelPack(BuiltinSource(), bytes, error)) return false;
+    return this->loadBytes(std::move(bytes), error);
+}
+
+size_t LevelPack::getSize() const {
+    if (!m_header) return 0;
+    return sizeof(LevelPackHeader) + m_header->levelCount * sizeof(LevelPackLevel)
+         + (size_t)m_header->populationCount * sizeof(LevelPackPopulation);
+}
+
+bool LevelPack::bind(const uint8_t* data, size_t size, std::string& error) {
+    if (size < sizeof(LevelPackHeader)) { error = "too small for a level pack"; return false; }
+    auto header = (const LevelPackHeader*)data;
+    if (header->magic != LEVEL_PACK_MAGIC) { error = "not a level pack"; return false; }
+    if (header->version != LEVEL_PACK_VERSION) {
+        error = "level pack version " + std::to_string(header->version) + ", expected " + std::to_string(LEVEL_PACK_VERSION);
+        return false;
+    }
+    size_t expected = sizeof(LevelPackHeader) + header->levelCount * sizeof(LevelPackLevel)
+                    + (size_t)header->populationCount * sizeof(LevelPackPopulation);
+    if (size != expected) { error = "truncated or padded level pack"; return false; }
+    if (header->levelCount == 0) { error = "level pack has no levels"; return false; }
+
+    auto levels = (const LevelPackLevel*)(data + sizeof(LevelPackHeader));
+    auto populations = (const LevelPackPopulation*)(levels + header->levelCount);
+    // checked once here so the game can index straight into the records afterwards
+    for (int i = 0; i < header->levelCount; ++i) {
+        const LevelPackLevel& level = levels[i];
+        if ((uint64_t)level.firstPopulation + level.populationCount > header->populationCount
+            || level.minSpeed == 0 || level.minSpeed > level.maxSpeed) {
+            error = "level record " + std::to_string(i) + " is out of range";
+            return false;
+        }
+        for (uint32_t p = 0; p < level.populationCount; ++p) {
+            if (populations[level.firstPopulation + p].creatureType >= kAquariumCreatureTypeCount) {
+                error = "level record " + std::to_string(i) + " has an unknown creature type";
+                return false;
+            }
+        }
+    }
+    m_header = header;
+    m_levels = levels;
+    m_populations = populations;
+    return true;
+}
+
+const char* LevelPack::BuiltinSource() {
+    return R"(# the levels the game originally shipped with
+level 0
+target 10
+fish BaseFish 10
+
+level 1
+target 15
+fish BaseFish 20
+fish PinkFish 10
+
+level 2
+target 20
+fish BaseFish 30
+fish BiggerFish 5
+fish PinkFish 10
+fish SharkFish 1
+
+level 3
+target 25
+fish BaseFish 27
+fish BiggerFish 6
+fish PinkFish 12
+fish SharkFish 2
+
+level 4
+target 30
+fish BaseFish 25
+fish BiggerFish 7
+fish PinkFish 13
+fish SharkFish 3
+)";
+}
+
+// Text format, one directive per line, '#' starts a comment:
+//   level N            starts a level, everything below belongs to it
+//   target SCORE       score needed to finish it, above 0 and required
+//   speed MIN MAX      spawn speed range (default 1 25)
+//   fish TYPE COUNT    population, TYPE is BaseFish, BiggerFish, PinkFish or SharkFish,
+//                      at most once per type in a level and COUNT above 0
+bool CompileLevelPack(const std::string& source, std::vector<uint8_t>& out, std::string& error) {
+    std::vector<LevelPackLevel> levels;
+    std::vector<LevelPackPopulation> populations;
+    std::istringstream lines(source);
+    std::string line;
+    int lineNumber = 0;
+    auto fail = [&](const std::string& message) {
+        error = "line " + std::to_string(lineNumber) + ": " + message;
+        return false;
+    };
+    // where the current level started and where each of its fish was listed, 0 for not yet
+    int levelLine = 0;
+    int fishLine[kAquariumCreatureTypeCount] = {};
+    auto finishLevel = [&]() {
+        if (levels.empty() || levels.back().targetScore > 0) return true;
+        lineNumber = levelLine; // the problem is the level, not the line that ended it
+        return fail("level " + std::to_string(levels.back().number) + " needs a target above 0");
+    };
+
+    while (std::getline(lines, line)) {
+        ++lineNumber;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::string directive;
+        if (!(words >> directive)) continue;
+
+        if (directive == "level") {
+            if (!finishLevel()) return false;
+            levelLine = lineNumber;
+            std::fill(std::begin(fishLine), std::end(fishLine), 0);
+            LevelPackLevel level = {};
+            if (!(words >> level.number)) return fail("level needs a number");
+            level.minSpeed = 1;
+            level.maxSpeed = 25;
+            level.firstPopulation = (uint32_t)populations.size();
+            levels.push_back(level);
+            continue;
+        }
+        if (levels.empty()) return fail("'" + directive + "' before the first level");
+        LevelPackLevel& level = levels.back();
+
+        if (directive == "target") {
+            int target = 0;
+            if (!(words >> target) || target <= 0) return fail("target needs a score above 0");
+            level.targetScore = (uint32_t)target;
+        } else if (directive == "speed") {
+            int minSpeed = 0, maxSpeed = 0;
+            if (!(words >> minSpeed >> maxSpeed) || minSpeed < 1 || maxSpeed < minSpeed || maxSpeed > 65535) {
+                return fail("speed needs MIN MAX with 1 <= MIN <= MAX");
+            }
+            level.minSpeed = (uint16_t)minSpeed;
+            level.maxSpeed = (uint16_t)maxSpeed;
+        } else if (directive == "fish") {
+            std::string type;
+            int count = 0;
+            if (!(words >> type >> count)) return fail("fish needs TYPE COUNT");
+            if (count <= 0) return fail("fish count has to be above 0");
+            LevelPackPopulation population = {};
+            bool known = false;
+            for (int t = 0; t < kAquariumCreatureTypeCount; ++t) {
+                if (AquariumCreatureTypeToString((AquariumCreatureType)t) == type) {
+                    population.creatureType = (uint8_t)t;
+                    known = true;
+                }
+            }
+            if (!known) return fail("unknown fish type '" + type + "'");
+            int& seen = fishLine[population.creatureType];
+            if (seen) return fail(type + " already listed for this level on line " + std::to_string(seen));
+            seen = lineNumber;
+            population.count = (uint32_t)count;
+            populations.push_back(population);
+            level.populationCount++;
+        } else {
+            return fail("unknown directive '" + directive + "'");
+        }
+    }
+    if (levels.empty()) return fail("no levels");
+    if (!finishLevel()) return false;
+    if (levels.size() > 65535) return fail("too many levels");
+
+    LevelPackHeader header = {};
+    header.magic = LEVEL_PACK_MAGIC;
+    header.version = LEVEL_PACK_VERSION;
+    header.levelCount = (uint16_t)levels.size();
+    header.populationCount = (uint32_t)populations.size();
+
+    out.resize(sizeof(header) + levels.size() * sizeof(LevelPackLevel) + populations.size() * sizeof(LevelPackPopulation));
+    uint8_t* cursor = out.data();
+    std::memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    std::memcpy(cursor, levels.data(), levels.size() * sizeof(LevelPackLevel));
+    cursor += levels.size() * sizeof(LevelPackLevel);
+    if (!populations.empty()) std::memcpy(cursor, populations.data(), populations.size() * sizeof(LevelPackPopulation));
+    return true;
+}
+
+int RunLevelPackCompiler(const std::string& inputPath, const std::string& outputPath) {
+    std::ifstream input(inputPath);
+    if (!input) {
+        std::fprintf(stderr, "cannot read %s\n", inputPath.c_str());
+        return 1;
+    }
+    std::stringstream source;
+    source << input.rdbuf();
+
+    std::vector<uint8_t> bytes;
+    std::string error;
+    if (!CompileLevelPack(source.str(), bytes, error)) {
+        std::fprintf(stderr, "%s: %s\n", inputPath.c_str(), error.c_str());
+        return 1;
+    }
+    std::ofstream output(outputPath, std::ios::binary);
+    output.write((const char*)bytes.data(), (std::streamsize)bytes.size());
+    if (!output) {
+        std::fprintf(stderr, "cannot write %s\n", outputPath.c_str());
+        return 1;
+    }
+    // read it back the way the game does
+    LevelPack pack;
+    output.close();
+    if (!pack.open(outputPath, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    std::printf("%s: %d levels, %zu bytes\n", outputPath.c_str(), pack.getLevelCount(), bytes.size());
+    return 0;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Compiled level pack (.aqlp). Levels are written as text (bin/data/levels.txt) and compiled
+// offline with `--compile-levels` into one little-endian blob of fixed size records that is
+// memory-mapped at startup and read in place, so loading costs a header check no matter how
+// many levels there are:
+//
+//   LevelPackHeader
+//   LevelPackLevel      x levelCount
+//   LevelPackPopulation x populationCount   (each level points at a contiguous run)
+//
+// Bump LEVEL_PACK_VERSION whenever a record changes; older packs are rejected, not guessed at.
+static const uint32_t LEVEL_PACK_MAGIC = 0x504C5141; // "AQLP"
+static const uint16_t LEVEL_PACK_VERSION = 2;
+
+struct LevelPackHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t levelCount;
+    uint32_t populationCount;
+    uint32_t reserved;
+};
+
+struct LevelPackLevel {
+    uint32_t number;
+    uint32_t targetScore;
+    uint16_t minSpeed;        // spawn speed is drawn from [minSpeed, maxSpeed]
+    uint16_t maxSpeed;
+    uint32_t firstPopulation; // index into the population records
+    uint32_t populationCount;
+    uint32_t reserved;
+};
+
+struct LevelPackPopulation {
+    uint8_t creatureType;     // AquariumCreatureType
+    uint8_t reserved[3];
+    uint32_t count;
+};
+
+static_assert(sizeof(LevelPackHeader) == 16, "pack layout is part of the file format");
+static_assert(sizeof(LevelPackLevel) == 24, "pack layout is part of the file format");
+static_assert(sizeof(LevelPackPopulation) == 8, "pack layout is part of the file format");
+
+// read-only view over a pack, either a mapped file or bytes we own (the built-in levels)
+class LevelPack {
+public:
+    LevelPack() = default;
+    ~LevelPack();
+    LevelPack(const LevelPack&) = delete;
+    LevelPack& operator=(const LevelPack&) = delete;
+
+    // maps the file and validates it, on failure error says why and the pack stays empty
+    bool open(const std::string& path, std::string& error);
+    bool loadBytes(std::vector<uint8_t> bytes, std::string& error);
+    void close();
+
+    // compiles BuiltinSource into bytes the pack owns
+    bool loadBuiltin(std::string& error);
+
+    int getLevelCount() const { return m_header ? m_header->levelCount : 0; }
+    const LevelPackLevel& getLevel(int i) const { return m_levels[i]; }
+    const LevelPackPopulation* getPopulation(const LevelPackLevel& level) const { return m_populations + level.firstPopulation; }
+    // the pack as it sits in memory, e.g. to tell two packs apart by checksum
+    const uint8_t* getData() const { return reinterpret_cast<const uint8_t*>(m_header); }
+    size_t getSize() const;
+
+    // the five levels the game shipped with, for when no pack file is around
+    static const char* BuiltinSource();
+
+private:
+    bool bind(const uint8_t* data, size_t size, std::string& error);
+
+    const LevelPackHeader* m_header = nullptr;
+    const LevelPackLevel* m_levels = nullptr;
+    const LevelPackPopulation* m_populations = nullptr;
+    std::vector<uint8_t> m_owned;
+    void* m_mapping = nullptr;
+    size_t m_mappingSize = 0;
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mapHandle = nullptr;
+#endif
+};
+
+// text -> pack bytes, error carries "line N: ..." on failure
+bool CompileLevelPack(const std::string& source, std::vector<uint8_t>& out, std::string& error);
+// --compile-levels IN OUT from main.cpp
+int RunLevelPackCompiler(const std::string& inputPath, const std::string& outputPath);
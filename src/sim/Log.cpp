@@ -0,0 +1,173 @@
+#include "Log.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace {
+
+void StderrSink(LogLevel level, const std::string& text) {
+    static const char* names[] = {"verbose", "notice", "warning", "error"};
+    std::fprintf(stderr, "[%s] %s\n", names[(int)level], text.c_str());
+}
+
+std::atomic<uint8_t> g_level{(uint8_t)LogLevel::Notice};
+std::atomic<LogSink> g_sink{&StderrSink};
+
+struct LogRecord {
+    LogLevel level;
+    const char* format;
+    int argCount;
+    LogArg args[AsyncLog::MAX_ARGS];
+};
+
+// bounded multi-producer queue (Vyukov): each cell's sequence says whose turn it is,
+// producers claim a position with one CAS, the writer thread is the only consumer
+struct LogCell {
+    std::atomic<uint64_t> sequence;
+    LogRecord record;
+};
+
+class LogQueue {
+public:
+    LogQueue() {
+        for (uint64_t i = 0; i < (uint64_t)AsyncLog::CAPACITY; ++i) m_cells[i].sequence.store(i, std::memory_order_relaxed);
+        m_writer = std::thread(&LogQueue::writerLoop, this);
+    }
+
+    ~LogQueue() {
+        m_stop.store(true, std::memory_order_release);
+        m_writer.join(); // drains what's left on the way out
+    }
+
+    bool push(const LogRecord& record) {
+        uint64_t pos = m_enqueue.load(std::memory_order_relaxed);
+        while (true) {
+            LogCell& cell = m_cells[pos & (AsyncLog::CAPACITY - 1)];
+            uint64_t sequence = cell.sequence.load(std::memory_order_acquire);
+            int64_t diff = (int64_t)sequence - (int64_t)pos;
+            if (diff == 0) {
+                if (m_enqueue.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.record = record;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                m_dropped.fetch_add(1, std::memory_order_relaxed);
+                return false; // full, the writer is behind
+            } else {
+                pos = m_enqueue.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void flush() {
+        uint64_t target = m_enqueue.load(std::memory_order_acquire);
+        while (m_written.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+private:
+    bool pop(LogRecord& out) {
+        LogCell& cell = m_cells[m_dequeue & (AsyncLog::CAPACITY - 1)];
+        if (cell.sequence.load(std::memory_order_acquire) != m_dequeue + 1) return false;
+        out = cell.record;
+        cell.sequence.store(m_dequeue + AsyncLog::CAPACITY, std::memory_order_release);
+        ++m_dequeue;
+        return true;
+    }
+
+    void writerLoop() {
+        std::string text;
+        LogRecord record;
+        while (true) {
+            bool stopping = m_stop.load(std::memory_order_acquire);
+            while (this->pop(record)) {
+                Format(record, text);
+                g_sink.load(std::memory_order_acquire)(record.level, text);
+                m_written.store(m_dequeue, std::memory_order_release);
+            }
+            if (stopping) return;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+    static void Format(const LogRecord& record, std::string& text) {
+        text.clear();
+        int next = 0;
+        for (const char* c = record.format; *c; ++c) {
+            if (c[0] == '{' && c[1] == '}' && next < record.argCount) {
+                AppendArg(record.args[next++], text);
+                ++c;
+            } else {
+                text.push_back(*c);
+            }
+        }
+    }
+
+    static void AppendArg(const LogArg& arg, std::string& text) {
+        char buffer[32];
+        switch (arg.kind) {
+            case LogArg::Int: std::snprintf(buffer, sizeof(buffer), "%lld", (long long)arg.i); break;
+            case LogArg::UInt: std::snprintf(buffer, sizeof(buffer), "%llu", (unsigned long long)arg.u); break;
+            case LogArg::Double: std::snprintf(buffer, sizeof(buffer), "%g", arg.d); break;
+            case LogArg::Bool: std::snprintf(buffer, sizeof(buffer), "%s", arg.u ? "true" : "false"); break;
+            case LogArg::Str: text += arg.s ? arg.s : "(null)"; return;
+        }
+        text += buffer;
+    }
+
+    LogCell m_cells[AsyncLog::CAPACITY];
+    std::atomic<uint64_t> m_enqueue{0};
+    uint64_t m_dequeue = 0; // writer thread only
+    std::atomic<uint64_t> m_written{0};
+    std::atomic<uint64_t> m_dropped{0};
+    std::atomic<bool> m_stop{false};
+    std::thread m_writer;
+};
+
+LogQueue& Queue() {
+    static LogQueue queue; // writer thread starts with the first message
+    return queue;
+}
+
+}
+
+void AsyncLog::Push(LogLevel level, const char* format, const LogArg* args, int argCount) {
+    LogRecord record;
+    record.level = level;
+    record.format = format;
+    record.argCount = argCount;
+    for (int i = 0; i < argCount; ++i) record.args[i] = args[i];
+    Queue().push(record);
+}
+
+void AsyncLog::Flush() {
+    Queue().flush();
+}
+
+uint64_t AsyncLog::GetDropped() {
+    return Queue().getDropped();
+}
+
+void AsyncLog::WriteText(LogLevel level, const std::string& text) {
+    if (level < GetLevel()) return;
+    Flush(); // whatever was queued before it still comes out first
+    g_sink.load(std::memory_order_acquire)(level, text);
+}
+
+void AsyncLog::SetLevel(LogLevel level) {
+    g_level.store((uint8_t)level, std::memory_order_relaxed);
+}
+
+LogLevel AsyncLog::GetLevel() {
+    return (LogLevel)g_level.load(std::memory_order_relaxed);
+}
+
+void AsyncLog::SetSink(LogSink sink) {
+    g_sink.store(sink ? sink : &StderrSink, std::memory_order_release);
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// Logging for code that runs every tick. Levels below AQUARIUM_LOG_MIN_LEVEL (a LogLevel
+// value, notice by default) compile to nothing, arguments included. Kept messages only copy
+// their format pointer and arguments into a lock-free ring; a background thread does the
+// "{}" formatting and hands the text to the sink (stderr unless the game points it at ofLog),
+// so a log line costs the frame no string building, locking or console I/O. When the ring
+// is full new messages are dropped and counted.
+//
+// The format and any const char* argument must stay valid until flushed, so string
+// literals only. Build with AQUARIUM_LOG_MIN_LEVEL=0 to get the verbose messages back.
+#ifndef AQUARIUM_LOG_MIN_LEVEL
+#define AQUARIUM_LOG_MIN_LEVEL 1
+#endif
+
+// same order and values as ofLogLevel so the game can pass them straight through
+enum class LogLevel : uint8_t {
+    Verbose,
+    Notice,
+    Warning,
+    Error,
+};
+
+// where formatted lines end up, called from the writer thread (or the caller for WriteText)
+using LogSink = void (*)(LogLevel level, const std::string& text);
+
+struct LogArg {
+    enum Kind : uint8_t { Int, UInt, Double, Bool, Str };
+    Kind kind;
+    union {
+        int64_t i;
+        uint64_t u;
+        double d;
+        const char* s;
+    };
+};
+
+template <typename T>
+LogArg MakeLogArg(T value) {
+    LogArg arg;
+    if constexpr (std::is_same<T, bool>::value) {
+        arg.kind = LogArg::Bool;
+        arg.u = value;
+    } else if constexpr (std::is_integral<T>::value || std::is_enum<T>::value) {
+        if constexpr (std::is_signed<T>::value || std::is_enum<T>::value) {
+            arg.kind = LogArg::Int;
+            arg.i = (int64_t)value;
+        } else {
+            arg.kind = LogArg::UInt;
+            arg.u = (uint64_t)value;
+        }
+    } else if constexpr (std::is_floating_point<T>::value) {
+        arg.kind = LogArg::Double;
+        arg.d = value;
+    } else {
+        static_assert(std::is_same<T, const char*>::value || std::is_same<T, char*>::value,
+                      "log arguments are numbers or string literals");
+        arg.kind = LogArg::Str;
+        arg.s = value;
+    }
+    return arg;
+}
+
+class AsyncLog {
+public:
+    static const int CAPACITY = 1024; // messages waiting for the writer thread
+    static const int MAX_ARGS = 6;
+
+    template <typename... Args>
+    static void Write(LogLevel level, const char* format, const Args&... args) {
+        static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+        if (level < GetLevel()) return; // runtime level still applies
+        LogArg packed[MAX_ARGS] = {MakeLogArg(typename std::decay<Args>::type(args))...};
+        Push(level, format, packed, (int)sizeof...(Args));
+    }
+
+    // for the odd message that has to be built at runtime (a file name, a parse error), off
+    // the hot path: flushes and writes right away on the calling thread, nothing is queued
+    static void WriteText(LogLevel level, const std::string& text);
+
+    // blocks until everything logged before the call has been written
+    static void Flush();
+    static uint64_t GetDropped();
+
+    // messages below this are skipped at runtime, notice by default
+    static void SetLevel(LogLevel level);
+    static LogLevel GetLevel();
+    // set before anything is logged, null goes back to stderr
+    static void SetSink(LogSink sink);
+
+private:
+    static void Push(LogLevel level, const char* format, const LogArg* args, int argCount);
+};
+
+#if AQUARIUM_LOG_MIN_LEVEL <= 0
+#define AQ_LOG_VERBOSE(...) AsyncLog::Write(LogLevel::Verbose, __VA_ARGS__)
+#else
+#define AQ_LOG_VERBOSE(...) ((void)0)
+#endif
+
+#if AQUARIUM_LOG_MIN_LEVEL <= 1
+#define AQ_LOG_NOTICE(...) AsyncLog::Write(LogLevel::Notice, __VA_ARGS__)
+#else
+#define AQ_LOG_NOTICE(...) ((void)0)
+#endif
+
+#if AQUARIUM_LOG_MIN_LEVEL <= 2
+#define AQ_LOG_WARNING(...) AsyncLog::Write(LogLevel::Warning, __VA_ARGS__)
+#else
+#define AQ_LOG_WARNING(...) ((void)0)
+#endif
+
+#if AQUARIUM_LOG_MIN_LEVEL <= 3
+#define AQ_LOG_ERROR(...) AsyncLog::Write(LogLevel::Error, __VA_ARGS__)
+#else
+#define AQ_LOG_ERROR(...) ((void)0)
+#endif
@@ -0,0 +1,108 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Zone {
+    const char* name;
+    uint64_t startUs;
+    uint64_t durationUs;
+};
+
+// written only by its own thread, read by WriteChromeTrace
+struct ThreadZones {
+    int tid = 0;
+    std::string name;
+    std::vector<Zone> ring;
+    std::atomic<uint64_t> written{0};
+};
+
+struct ProfilerState {
+    std::mutex mutex; // guards threads, taken once per thread and when dumping
+    std::vector<std::unique_ptr<ThreadZones>> threads; // never shrinks, zones outlive their thread
+    std::atomic<bool> enabled{true};
+    std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+};
+
+ProfilerState& State() {
+    static ProfilerState state;
+    return state;
+}
+
+ThreadZones& LocalZones() {
+    thread_local ThreadZones* zones = nullptr;
+    if (!zones) {
+        ProfilerState& state = State();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.threads.push_back(std::make_unique<ThreadZones>());
+        zones = state.threads.back().get();
+        zones->tid = (int)state.threads.size();
+        zones->name = "thread " + std::to_string(zones->tid);
+        zones->ring.resize(Profiler::ZONES_PER_THREAD);
+    }
+    return *zones;
+}
+
+}
+
+void Profiler::SetEnabled(bool enabled) { State().enabled.store(enabled, std::memory_order_relaxed); }
+bool Profiler::IsEnabled() { return State().enabled.load(std::memory_order_relaxed); }
+
+void Profiler::SetThreadName(const std::string& name) {
+    ThreadZones& zones = LocalZones();
+    std::lock_guard<std::mutex> lock(State().mutex);
+    zones.name = name;
+}
+
+uint64_t Profiler::NowUs() {
+    auto elapsed = std::chrono::steady_clock::now() - State().epoch;
+    // +1 so a zone starting right at the epoch isn't mistaken for "not recording"
+    return (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count() + 1;
+}
+
+void Profiler::Record(const char* name, uint64_t startUs, uint64_t endUs) {
+    ThreadZones& zones = LocalZones();
+    uint64_t n = zones.written.load(std::memory_order_relaxed);
+    zones.ring[n & (ZONES_PER_THREAD - 1)] = Zone{name, startUs, endUs - startUs};
+    zones.written.store(n + 1, std::memory_order_release);
+}
+
+int Profiler::GetZoneCount() {
+    ProfilerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    uint64_t total = 0;
+    for (auto& zones : state.threads) {
+        total += std::min<uint64_t>(zones->written.load(std::memory_order_acquire), ZONES_PER_THREAD);
+    }
+    return (int)total;
+}
+
+bool Profiler::WriteChromeTrace(const std::string& path) {
+    FILE* out = std::fopen(path.c_str(), "w");
+    if (!out) return false;
+
+    ProfilerState& state = State();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    std::fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (auto& zones : state.threads) {
+        std::fprintf(out, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                     first ? "" : ",\n", zones->tid, zones->name.c_str());
+        first = false;
+        uint64_t written = zones->written.load(std::memory_order_acquire);
+        uint64_t begin = written > (uint64_t)ZONES_PER_THREAD ? written - ZONES_PER_THREAD : 0;
+        for (uint64_t i = begin; i < written; ++i) {
+            const Zone& zone = zones->ring[i & (ZONES_PER_THREAD - 1)];
+            std::fprintf(out, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%llu,\"dur\":%llu}",
+                         zone.name, zones->tid, (unsigned long long)zone.startUs, (unsigned long long)zone.durationUs);
+        }
+    }
+    std::fprintf(out, "\n]}\n");
+    return std::fclose(out) == 0;
+}
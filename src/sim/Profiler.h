@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+// Scoped zone profiler. AQ_PROFILE_SCOPE("name") records the wall time of the enclosing
+// scope into a ring buffer owned by the calling thread, no locks or allocations once the
+// thread has its buffer. Profiler::WriteChromeTrace dumps every thread's zones as a trace
+// JSON that chrome://tracing and ui.perfetto.dev open directly.
+//
+// Build with AQUARIUM_PROFILER=0 (PROJECT_DEFINES in config.make) to compile every zone
+// out; when compiled in, recording can still be switched off at runtime.
+#ifndef AQUARIUM_PROFILER
+#define AQUARIUM_PROFILER 1
+#endif
+
+class Profiler {
+public:
+    static const int ZONES_PER_THREAD = 1 << 16; // oldest zones get overwritten past this
+
+    static void SetEnabled(bool enabled);
+    static bool IsEnabled();
+    // label for the calling thread's track in the trace
+    static void SetThreadName(const std::string& name);
+    // name has to outlive the profiler, string literals only
+    static void Record(const char* name, uint64_t startUs, uint64_t endUs);
+    static uint64_t NowUs();
+    // call while no other thread is recording, e.g. between frames
+    static bool WriteChromeTrace(const std::string& path);
+    static int GetZoneCount(); // zones currently held across all threads
+};
+
+#if AQUARIUM_PROFILER
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) : m_name(name), m_start(Profiler::IsEnabled() ? Profiler::NowUs() : 0) {}
+    ~ProfileScope() {
+        if (m_start) Profiler::Record(m_name, m_start, Profiler::NowUs());
+    }
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+private:
+    const char* m_name;
+    uint64_t m_start;
+};
+
+#define AQ_PROFILE_CONCAT_INNER(a, b) a##b
+#define AQ_PROFILE_CONCAT(a, b) AQ_PROFILE_CONCAT_INNER(a, b)
+#define AQ_PROFILE_SCOPE(name) ProfileScope AQ_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#else
+
+#define AQ_PROFILE_SCOPE(name) do {} while (0)
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstdint>
+
+// Small seedable generator (PCG32, O'Neill 2014) used instead of the global rand().
+// Every Aquarium owns one seeded stream and gives each creature it spawns its own
+// substream, so a seed fully determines a run and creatures never share hidden
+// state, whatever order or thread they are updated on.
+class RandomStream {
+public:
+    RandomStream() { this->seed(0x853c49e6748fea9bULL, 0); }
+    RandomStream(uint64_t seed, uint64_t stream) { this->seed(seed, stream); }
+
+    void seed(uint64_t seed, uint64_t stream) {
+        m_state = 0;
+        m_inc = (stream << 1u) | 1u; // must be odd
+        next();
+        m_state += seed;
+        next();
+    }
+
+    uint32_t next() {
+        uint64_t old = m_state;
+        m_state = old * 6364136223846793005ULL + m_inc;
+        uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+        uint32_t rot = (uint32_t)(old >> 59u);
+        return (xorshifted >> rot) | (xorshifted << ((~rot + 1u) & 31));
+    }
+
+    // uniform in [0, n), n must be positive
+    int nextInt(int n) { return (int)(((uint64_t)next() * (uint32_t)n) >> 32); }
+
+    // uniform in [0, 1)
+    float nextFloat() { return (next() >> 8) * (1.0f / 16777216.0f); }
+
+    // independent stream number `id` derived from `seed`, ids are usually spawn counters
+    static RandomStream Substream(uint64_t seed, uint64_t id) {
+        return RandomStream(SplitMix64(seed ^ SplitMix64(id)), id);
+    }
+
+    uint64_t getState() const { return m_state; }
+    uint64_t getIncrement() const { return m_inc; }
+    void setState(uint64_t state, uint64_t increment) { m_state = state; m_inc = increment | 1u; }
+
+    bool operator==(const RandomStream& other) const { return m_state == other.m_state && m_inc == other.m_inc; }
+
+private:
+    static uint64_t SplitMix64(uint64_t x) {
+        x += 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t m_state = 0;
+    uint64_t m_inc = 1;
+};
@@ -0,0 +1,320 @@
+#include "Replay.h"
+#include "Snapshot.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+// ReplayRecorder
+void ReplayRecorder::start(const AquariumGameScene& scene, const ReplaySetup& setup, bool fromSnapshot) {
+    m_header = {};
+    m_header.magic = REPLAY_MAGIC;
+    m_header.version = REPLAY_VERSION;
+    m_header.seed = setup.seed;
+    m_header.levelsChecksum = setup.levelsChecksum;
+    m_header.width = setup.width;
+    m_header.height = setup.height;
+    m_header.playerSpeed = setup.playerSpeed;
+    m_header.checksumInterval = (uint32_t)std::max(setup.checksumInterval, 1);
+    m_maxTicks = (uint32_t)std::max(setup.maxTicks, 1);
+    m_maxEvents = (size_t)std::max(setup.maxEvents, 1);
+    m_events.clear();
+    m_checksums.clear();
+    m_snapshot.clear();
+    // a rate the header can't hold would play back at another one and fail every checksum
+    if (setup.tickHz < 1 || setup.tickHz > UINT16_MAX) {
+        m_recording = false;
+        AQ_LOG_WARNING("replay not recorded: tick rate {} doesn't fit the file format", setup.tickHz);
+        return;
+    }
+    m_header.tickHz = (uint16_t)setup.tickHz;
+    if (fromSnapshot) scene.SaveSnapshot(m_snapshot);
+    m_recording = true;
+    this->addChecksum(scene); // tick 0, catches a scene that doesn't rebuild the same from the seed
+}
+
+void ReplayRecorder::recordInput(AquariumInput input, bool pressed) {
+    if (!m_recording) return;
+    ReplayEvent event = {};
+    event.tick = m_header.tickCount;
+    event.kind = (uint8_t)input;
+    event.pressed = pressed;
+    m_events.push_back(event);
+    this->stopWhenFull();
+}
+
+void ReplayRecorder::recordResize(int width, int height) {
+    if (!m_recording) return;
+    // the simulation got this size, a clamped one would play back different walls; what is
+    // recorded up to here still plays back
+    if (width < 0 || width > UINT16_MAX || height < 0 || height > UINT16_MAX) {
+        m_recording = false;
+        AQ_LOG_WARNING("replay recording stopped at {} ticks: resize to {}x{} doesn't fit the file format",
+                       m_header.tickCount, width, height);
+        return;
+    }
+    ReplayEvent event = {};
+    event.tick = m_header.tickCount;
+    event.kind = REPLAY_RESIZE;
+    event.width = (uint16_t)width;
+    event.height = (uint16_t)height;
+    m_events.push_back(event);
+    this->stopWhenFull();
+}
+
+void ReplayRecorder::noteTick(const AquariumGameScene& scene) {
+    if (!m_recording) return;
+    m_header.tickCount++;
+    if (m_header.tickCount % m_header.checksumInterval == 0) this->addChecksum(scene);
+    this->stopWhenFull();
+}
+
+// what is recorded up to here still plays back, it just ends early
+void ReplayRecorder::stopWhenFull() {
+    if (m_header.tickCount < m_maxTicks && m_events.size() < m_maxEvents) return;
+    m_recording = false;
+    AQ_LOG_NOTICE("replay recording full at {} ticks and {} inputs, stopped", m_header.tickCount, m_events.size());
+}
+
+void ReplayRecorder::addChecksum(const AquariumGameScene& scene) {
+    scene.SaveSnapshot(m_scratch);
+    ReplayChecksum checksum = {};
+    checksum.tick = m_header.tickCount;
+    checksum.checksum = ChecksumBytes(m_scratch.data(), m_scratch.size());
+    m_checksums.push_back(checksum);
+}
+
+bool ReplayRecorder::save(const std::string& path, std::string& error) const {
+    ReplayHeader header = m_header;
+    header.snapshotSize = (uint32_t)m_snapshot.size();
+    header.eventCount = (uint32_t)m_events.size();
+    header.checksumCount = (uint32_t)m_checksums.size();
+
+    std::ofstream out(path, std::ios::binary);
+    out.write((const char*)&header, sizeof(header));
+    out.write((const char*)m_snapshot.data(), (std::streamsize)m_snapshot.size());
+    out.write((const char*)m_events.data(), (std::streamsize)(m_events.size() * sizeof(ReplayEvent)));
+    out.write((const char*)m_checksums.data(), (std::streamsize)(m_checksums.size() * sizeof(ReplayChecksum)));
+    if (!out) {
+        error = "cannot write " + path;
+        return false;
+    }
+    return true;
+}
+
+// ReplayFile
+bool ReplayFile::load(const std::string& path, std::string& error) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        error = "cannot open " + path;
+        return false;
+    }
+    std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    if (bytes.size() < sizeof(ReplayHeader)) {
+        error = "too small for a replay";
+        return false;
+    }
+    std::memcpy(&header, bytes.data(), sizeof(header));
+    if (header.magic != REPLAY_MAGIC) {
+        error = "not a replay";
+        return false;
+    }
+    if (header.version != REPLAY_VERSION) {
+        error = "replay version " + std::to_string(header.version) + ", expected " + std::to_string(REPLAY_VERSION);
+        return false;
+    }
+    size_t eventBytes = (size_t)header.eventCount * sizeof(ReplayEvent);
+    size_t checksumBytes = (size_t)header.checksumCount * sizeof(ReplayChecksum);
+    if (bytes.size() != sizeof(ReplayHeader) + header.snapshotSize + eventBytes + checksumBytes) {
+        error = "replay size doesn't match its counts";
+        return false;
+    }
+    if (header.checksumInterval == 0) {
+        error = "replay has no checksum interval";
+        return false;
+    }
+
+    const uint8_t* p = bytes.data() + sizeof(ReplayHeader);
+    snapshot.assign(p, p + header.snapshotSize);
+    p += header.snapshotSize;
+    events.resize(header.eventCount);
+    if (eventBytes) std::memcpy(events.data(), p, eventBytes);
+    p += eventBytes;
+    checksums.resize(header.checksumCount);
+    if (checksumBytes) std::memcpy(checksums.data(), p, checksumBytes);
+
+    // playback walks both in order and never looks back
+    for (size_t i = 0; i < events.size(); ++i) {
+        bool known = events[i].kind <= (uint8_t)AquariumInput::ResetPopulation || events[i].kind == REPLAY_RESIZE;
+        if (!known || events[i].tick > header.tickCount || (i > 0 && events[i].tick < events[i - 1].tick)) {
+            error = "replay event " + std::to_string(i) + " is out of order or unknown";
+            return false;
+        }
+    }
+    for (size_t i = 1; i < checksums.size(); ++i) {
+        if (checksums[i].tick <= checksums[i - 1].tick) {
+            error = "replay checksums are out of order";
+            return false;
+        }
+    }
+    return true;
+}
+
+// playback
+ReplayResult PlayReplay(const ReplayFile& replay, const LevelPack& levels, CreatureStorage storage, int threads, bool verify) {
+    ReplayResult result;
+    const ReplayHeader& header = replay.header;
+    if (ChecksumBytes(levels.getData(), levels.getSize()) != header.levelsChecksum) {
+        result.error = "recorded with a different level pack";
+        return result;
+    }
+    double tickHz = header.tickHz ? header.tickHz : kAquariumDesignTickHz;
+    auto scene = CreateAquariumGameScene(header.width, header.height, header.playerSpeed, header.seed, &levels, tickHz);
+    scene->GetAquarium()->setStorage(storage);
+    scene->GetAquarium()->setThreadCount(threads);
+    if (!replay.snapshot.empty() && !scene->RestoreSnapshot(replay.snapshot.data(), replay.snapshot.size(), result.error)) {
+        result.error = "replay snapshot: " + result.error;
+        return result;
+    }
+
+    std::vector<uint8_t> state;
+    size_t nextEvent = 0;
+    size_t nextChecksum = 0;
+    // false once the state at tick differs from what was recorded
+    auto check = [&](uint32_t tick) {
+        if (!verify || nextChecksum >= replay.checksums.size() || replay.checksums[nextChecksum].tick != tick) return true;
+        scene->SaveSnapshot(state);
+        if (ChecksumBytes(state.data(), state.size()) != replay.checksums[nextChecksum++].checksum) return false;
+        result.checksumsVerified++;
+        return true;
+    };
+
+    auto start = std::chrono::steady_clock::now();
+    if (!check(0)) result.mismatchTick = 0;
+    for (uint32_t tick = 0; tick < header.tickCount && result.mismatchTick < 0; ++tick) {
+        for (; nextEvent < replay.events.size() && replay.events[nextEvent].tick == tick; ++nextEvent) {
+            const ReplayEvent& event = replay.events[nextEvent];
+            if (event.kind == REPLAY_RESIZE) scene->Resize(event.width, event.height);
+            else scene->ApplyInput((AquariumInput)event.kind, event.pressed != 0);
+        }
+        scene->Update();
+        result.ticksRun++;
+        if (!check(tick + 1)) result.mismatchTick = (int)tick + 1;
+    }
+    AsyncLog::Flush(); // keep the game's messages ahead of the report
+    result.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return result;
+}
+
+int RunReplay(const HeadlessOptions& options) {
+    ReplayFile replay;
+    std::string error;
+    if (!replay.load(options.replayPath, error)) {
+        std::fprintf(stderr, "%s: %s\n", options.replayPath.c_str(), error.c_str());
+        return 1;
+    }
+    LevelPack levels;
+    bool opened = options.levelsPath.empty() ? levels.loadBuiltin(error) : levels.open(options.levelsPath, error);
+    if (!opened) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    ReplayResult result = PlayReplay(replay, levels, options.storage, options.threads, options.verifyReplay);
+    if (!result.error.empty()) {
+        std::fprintf(stderr, "%s: %s\n", options.replayPath.c_str(), result.error.c_str());
+        return 1;
+    }
+    const ReplayHeader& header = replay.header;
+    std::printf("replay %s: %u ticks, %u inputs, seed %llu%s, %s storage, %d thread(s)\n", options.replayPath.c_str(),
+                header.tickCount, header.eventCount, (unsigned long long)header.seed,
+                replay.snapshot.empty() ? "" : " + snapshot",
+                options.storage == CreatureStorage::Arrays ? "arrays" : "objects", options.threads);
+    std::printf("  wall time     %.3f s\n", result.seconds);
+    std::printf("  ticks/sec     %.0f\n", result.ticksRun / std::max(result.seconds, 1e-9));
+    if (!options.verifyReplay) {
+        std::printf("  checksums     skipped\n");
+        return 0;
+    }
+    std::printf("  checksums     %d of %u verified (every %u ticks)\n", result.checksumsVerified,
+                header.checksumCount, header.checksumInterval);
+    if (result.mismatchTick >= 0) {
+        std::printf("  MISMATCH      state differs from the recording at tick %d\n", result.mismatchTick);
+        return 1;
+    }
+    std::printf("  result        ok\n");
+    return 0;
+}
+
+int RunRecordedSession(const HeadlessOptions& options) {
+    if (options.populationScale > 1) {
+        std::fprintf(stderr, "--record can't keep --population-scale, the session presses ']' itself\n");
+        return 2;
+    }
+    LevelPack levels;
+    std::string error;
+    bool opened = options.levelsPath.empty() ? levels.loadBuiltin(error) : levels.open(options.levelsPath, error);
+    if (!opened) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+
+    ReplaySetup setup;
+    setup.seed = options.seed;
+    setup.width = options.width;
+    setup.height = options.height;
+    setup.playerSpeed = options.playerSpeed;
+    setup.tickHz = (int)options.tickHz;
+    setup.levelsChecksum = ChecksumBytes(levels.getData(), levels.getSize());
+    setup.checksumInterval = 1; // a desync shows up at the exact tick
+    setup.maxTicks = options.ticks;
+    auto scene = CreateAquariumGameScene(setup.width, setup.height, setup.playerSpeed, setup.seed, &levels, setup.tickHz);
+    scene->GetAquarium()->setStorage(options.storage);
+    scene->GetAquarium()->setThreadCount(options.threads);
+    ReplayRecorder recorder;
+    recorder.start(*scene, setup, false);
+    if (!recorder.isRecording()) {
+        AsyncLog::Flush();
+        return 1; // the recorder said why
+    }
+
+    // inputs go through the scene and the recorder together, the same way ofApp does it
+    auto input = [&](AquariumInput key, bool pressed) {
+        scene->ApplyInput(key, pressed);
+        recorder.recordInput(key, pressed);
+    };
+    RandomStream script = RandomStream::Substream(options.seed, 0);
+    AquariumInput held = AquariumInput::Right;
+    input(held, true);
+    for (int tick = 0; tick < options.ticks; ++tick) {
+        if (tick % 45 == 44) {
+            // let go of the arrow and take another, sometimes the same one again
+            input(held, false);
+            held = (AquariumInput)script.nextInt((int)AquariumInput::Right + 1);
+            input(held, true);
+        }
+        if (tick == options.ticks / 4) input(AquariumInput::GrowPopulation, true);
+        if (tick == options.ticks / 2) {
+            int width = setup.width * 3 / 4;
+            int height = setup.height * 3 / 4;
+            scene->Resize(width, height);
+            recorder.recordResize(width, height);
+        }
+        if (tick == options.ticks * 3 / 4) input(AquariumInput::ResetPopulation, true);
+        scene->Update();
+        recorder.noteTick(*scene);
+    }
+    AsyncLog::Flush(); // keep the game's messages ahead of the report
+
+    if (!recorder.save(options.recordPath, error)) {
+        std::fprintf(stderr, "%s\n", error.c_str());
+        return 1;
+    }
+    std::printf("recorded %d ticks to %s\n", recorder.getTickCount(), options.recordPath.c_str());
+    HeadlessOptions playback = options;
+    playback.replayPath = options.recordPath;
+    return RunReplay(playback);
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "Aquarium.h"
+#include "HeadlessRunner.h"
+#include "LevelPack.h"
+
+// Recorded play session (.aqrp). Instead of frames it stores what went into the simulation:
+// the seed (or a snapshot when recording started mid game), every input stamped with the
+// scene tick it arrived before, and a checksum of the scene state every few ticks. Playing it
+// back runs the same ticks headless as fast as they go and compares checksums, so a real
+// session doubles as a benchmark workload and as a regression test for determinism.
+//
+//   ReplayHeader
+//   snapshot bytes      x snapshotSize (none when the session started from the seed)
+//   ReplayEvent         x eventCount
+//   ReplayChecksum      x checksumCount
+//
+// Same rules as the other formats: little-endian fixed size records, the version is bumped
+// on any change. A replay only plays back against the build and level pack it was made with.
+static const uint32_t REPLAY_MAGIC = 0x50525141; // "AQRP"
+static const uint16_t REPLAY_VERSION = 1;
+static const uint8_t REPLAY_RESIZE = 0xFF; // ReplayEvent::kind for a window resize
+
+struct ReplayHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t tickHz;          // Update calls per second, 0 (recorded before it was kept) means 60
+    uint64_t seed;
+    uint64_t levelsChecksum;  // ChecksumBytes of the level pack
+    int32_t width;            // window size when recording started
+    int32_t height;
+    int32_t playerSpeed;
+    uint32_t checksumInterval;
+    uint32_t tickCount;
+    uint32_t snapshotSize;
+    uint32_t eventCount;
+    uint32_t checksumCount;
+};
+
+struct ReplayEvent {
+    uint32_t tick;    // scene Updates that ran before it
+    uint8_t kind;     // AquariumInput, or REPLAY_RESIZE
+    uint8_t pressed;
+    uint16_t width;   // REPLAY_RESIZE only
+    uint16_t height;
+    uint16_t reserved;
+};
+
+struct ReplayChecksum {
+    uint32_t tick;    // scene Updates that ran before the state was hashed
+    uint32_t reserved;
+    uint64_t checksum; // ChecksumBytes of the scene snapshot
+};
+
+static_assert(sizeof(ReplayHeader) == 56, "replay layout is part of the file format");
+static_assert(sizeof(ReplayEvent) == 12, "replay layout is part of the file format");
+static_assert(sizeof(ReplayChecksum) == 16, "replay layout is part of the file format");
+
+// what the scene was made from, the recorder can't ask the scene for it
+struct ReplaySetup {
+    uint64_t seed = 0;
+    int width = 0;
+    int height = 0;
+    int playerSpeed = 0;
+    int tickHz = (int)kAquariumDesignTickHz;
+    uint64_t levelsChecksum = 0;
+    // ticks between checksums: once a second keeps a live game from snapshotting every tick,
+    // 1 pins a desync down to the exact tick (for recordings made headless to verify against)
+    int checksumInterval = 60;
+    // recording stops here and the file holds the session up to that point; an hour at 60
+    // ticks/sec, so a game left running can't grow the recording without end
+    int maxTicks = 60 * 60 * 60;
+    int maxEvents = 1 << 20;
+};
+
+// Sits next to a live scene: ofApp tells it about every input it applies and every Update it
+// runs. Recording costs one snapshot per checksum, small next to the tick at game sizes with
+// the default interval, and memory bounded by ReplaySetup::maxTicks and maxEvents.
+class ReplayRecorder {
+public:
+    // drops whatever was recorded and starts over from the scene as it is now; a scene that
+    // hasn't run yet is rebuilt from the seed on playback, otherwise its snapshot is kept.
+    // Nothing is recorded when setup.tickHz is outside 1..65535.
+    void start(const AquariumGameScene& scene, const ReplaySetup& setup, bool fromSnapshot);
+    void stop() { m_recording = false; }
+    bool isRecording() const { return m_recording; }
+    int getTickCount() const { return (int)m_header.tickCount; }
+
+    void recordInput(AquariumInput input, bool pressed);
+    // stops recording (with a warning) on a size outside 0..65535, the events only hold 16 bits
+    void recordResize(int width, int height);
+    // after every scene Update
+    void noteTick(const AquariumGameScene& scene);
+
+    // whatever is recorded so far, recording carries on
+    bool save(const std::string& path, std::string& error) const;
+
+private:
+    void addChecksum(const AquariumGameScene& scene);
+    void stopWhenFull();
+
+    bool m_recording = false;
+    ReplayHeader m_header = {};
+    uint32_t m_maxTicks = 0;
+    size_t m_maxEvents = 0;
+    std::vector<uint8_t> m_snapshot;
+    std::vector<ReplayEvent> m_events;
+    std::vector<ReplayChecksum> m_checksums;
+    std::vector<uint8_t> m_scratch; // reused by every checksum
+};
+
+// a whole replay file read into memory
+struct ReplayFile {
+    ReplayHeader header = {};
+    std::vector<uint8_t> snapshot;
+    std::vector<ReplayEvent> events;
+    std::vector<ReplayChecksum> checksums;
+
+    bool load(const std::string& path, std::string& error);
+};
+
+struct ReplayResult {
+    int ticksRun = 0;
+    double seconds = 0;
+    int checksumsVerified = 0;
+    int mismatchTick = -1;    // first tick whose state differs from the recording
+    std::string error;        // set when playback could not start
+};
+
+// plays the file back on a fresh headless scene, verify=false skips the checksums for
+// plain throughput runs
+ReplayResult PlayReplay(const ReplayFile& replay, const LevelPack& levels, CreatureStorage storage, int threads, bool verify);
+
+// --headless --replay FILE: loads, plays and prints the report, returns the exit code
+int RunReplay(const HeadlessOptions& options);
+
+// --headless --record FILE: plays a scripted session (steering, both population keys and a
+// resize, all driven by the seed) through a recorder with a checksum every tick, writes it to
+// FILE and then plays the file back with RunReplay, so record, save, load and verify all run
+int RunRecordedSession(const HeadlessOptions& options);
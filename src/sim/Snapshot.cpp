@@ -0,0 +1,310 @@
+#include "Snapshot.h"
+#include "Aquarium.h"
+#include <algorithm>
+#include <cstring>
+
+static_assert(kAquariumCreatureTypeCount == 4, "SnapshotLevel::population and SnapshotHeader::typeCounts have one entry per type");
+
+size_t SnapshotSize(int levelCount, int powerUpCount, int creatureCount) {
+    return sizeof(SnapshotHeader) + sizeof(SnapshotScene) + sizeof(SnapshotPlayer) + sizeof(SnapshotWorld)
+         + sizeof(SnapshotLevel) * (size_t)levelCount + sizeof(SnapshotPowerUp) * (size_t)powerUpCount
+         + CreatureStore::PackedSize(creatureCount);
+}
+
+uint64_t ChecksumBytes(const uint8_t* data, size_t size) {
+    const uint64_t prime = 0x100000001B3ull;
+    uint64_t h = 0xCBF29CE484222325ull ^ size;
+    size_t words = size / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t w;
+        std::memcpy(&w, data + i * 8, 8);
+        h = (h ^ w) * prime;
+        h ^= h >> 29;
+    }
+    for (size_t i = words * 8; i < size; ++i) h = (h ^ data[i]) * prime;
+    // final avalanche so the last few words reach every bit
+    h = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ull;
+    h = (h ^ (h >> 27)) * 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+bool SnapshotView::parse(const uint8_t* data, size_t size, std::string& error) {
+    if (size < sizeof(SnapshotHeader)) {
+        error = "too small for a snapshot";
+        return false;
+    }
+    const SnapshotHeader* h = reinterpret_cast<const SnapshotHeader*>(data);
+    if (h->magic != SNAPSHOT_MAGIC) {
+        error = "not a snapshot";
+        return false;
+    }
+    if (h->version != SNAPSHOT_VERSION) {
+        error = "snapshot version " + std::to_string(h->version) + ", expected " + std::to_string(SNAPSHOT_VERSION);
+        return false;
+    }
+    if (size != SnapshotSize(h->levelCount, h->powerUpCount, h->creatureCount)) {
+        error = "snapshot size doesn't match its counts";
+        return false;
+    }
+    uint64_t typed = 0;
+    for (uint32_t typeCount : h->typeCounts) typed += typeCount;
+    if (typed != h->creatureCount) {
+        error = "snapshot type counts don't add up to its creature count";
+        return false;
+    }
+    const uint8_t* p = data + sizeof(SnapshotHeader);
+    header = h;
+    scene = reinterpret_cast<const SnapshotScene*>(p);    p += sizeof(SnapshotScene);
+    player = reinterpret_cast<const SnapshotPlayer*>(p);  p += sizeof(SnapshotPlayer);
+    world = reinterpret_cast<const SnapshotWorld*>(p);    p += sizeof(SnapshotWorld);
+    levels = reinterpret_cast<const SnapshotLevel*>(p);   p += sizeof(SnapshotLevel) * h->levelCount;
+    powerUps = reinterpret_cast<const SnapshotPowerUp*>(p); p += sizeof(SnapshotPowerUp) * h->powerUpCount;
+    creatures = p;
+
+    // a bad tag would index past the groups; a max without early exit vectorizes
+    creatureTypes = CreatureStore::PackedTypes(creatures, h->creatureCount);
+    uint8_t maxType = 0;
+    for (uint32_t i = 0; i < h->creatureCount; ++i) maxType = std::max(maxType, creatureTypes[i]);
+    if (h->creatureCount > 0 && maxType >= kAquariumCreatureTypeCount) {
+        error = "snapshot has an unknown creature type";
+        return false;
+    }
+    return true;
+}
+
+// PlayerCreature
+void PlayerCreature::saveSnapshot(SnapshotPlayer& out) const {
+    std::memset(&out, 0, sizeof(out));
+    out.x = m_x; out.y = m_y; out.prevX = m_prevX; out.prevY = m_prevY;
+    out.dx = m_dx; out.dy = m_dy;
+    out.collisionRadius = m_collisionRadius;
+    out.visualScale = m_visualScale;
+    out.speed = m_speed;
+    out.score = m_score;
+    out.lives = m_lives;
+    out.power = m_power;
+    out.damageDebounce = m_damage_debounce;
+    out.flipped = m_flipped;
+}
+
+void PlayerCreature::loadSnapshot(const SnapshotPlayer& in) {
+    m_x = in.x; m_y = in.y; m_prevX = in.prevX; m_prevY = in.prevY;
+    m_dx = in.dx; m_dy = in.dy;
+    m_collisionRadius = in.collisionRadius;
+    m_visualScale = in.visualScale;
+    m_speed = in.speed;
+    m_score = in.score;
+    m_lives = in.lives;
+    m_power = in.power;
+    m_damage_debounce = in.damageDebounce;
+    m_flipped = in.flipped != 0;
+}
+
+// AquariumLevel
+int AquariumLevel::getPopulation(AquariumCreatureType type) const {
+    int node = m_nodeByType[(int)type];
+    return node < 0 ? -1 : m_levelPopulation[node]->population;
+}
+
+void AquariumLevel::setPopulation(AquariumCreatureType type, int population) {
+    int node = m_nodeByType[(int)type];
+    if (node >= 0) m_levelPopulation[node]->population = population;
+    this->scaleTargetScore();
+}
+
+// Aquarium
+void Aquarium::saveSnapshot(SnapshotWorld& world, SnapshotLevel* levels, SnapshotPowerUp* powerUps, uint8_t* creatures) const {
+    std::memset(&world, 0, sizeof(world));
+    world.seed = m_seed;
+    world.rngState = m_rng.getState();
+    world.rngIncrement = m_rng.getIncrement();
+    world.spawnCount = m_spawnCount;
+    world.currentLevel = currentLevel;
+    world.repopulatePending = m_repopulatePending;
+
+    for (size_t i = 0; i < m_aquariumlevels.size(); ++i) {
+        std::memset(&levels[i], 0, sizeof(SnapshotLevel)); // reserved bytes go into the checksum
+        levels[i].score = m_aquariumlevels[i]->getScore();
+        for (int t = 0; t < kAquariumCreatureTypeCount; ++t) {
+            levels[i].population[t] = m_aquariumlevels[i]->getPopulation((AquariumCreatureType)t);
+        }
+    }
+    for (size_t i = 0; i < m_powerups.size(); ++i) {
+        powerUps[i] = {m_powerups[i]->getX(), m_powerups[i]->getY(), m_powerups[i]->getRadius(), 0};
+    }
+
+    // array storage already has the columns in creature order, objects get gathered first
+    if (m_storage == CreatureStorage::Arrays) {
+        m_store.pack(creatures);
+        return;
+    }
+    int count = (int)m_creatures.size();
+    m_snapshotStore.resize(count);
+    for (int i = 0; i < count; ++i) {
+        const Creature* creature = m_creatures[i].get();
+        m_snapshotStore.copyIn(i, creature, (int)static_cast<const NPCreature*>(creature)->GetType());
+    }
+    m_snapshotStore.pack(creatures);
+}
+
+void Aquarium::spareForSnapshot(int index, int type) {
+    Creature* creature = m_creatures[index].get();
+    m_registry.remove(creature->getHandle());
+    m_groups.remove(type, creature);
+    if (m_storage == CreatureStorage::Arrays) m_store.unbind(index);
+    creature->setAquariumIndex(-1);
+    m_snapshotSpares[type].push_back(std::move(m_creatures[index]));
+}
+
+void Aquarium::restoreSnapshot(const SnapshotView& view) {
+    currentLevel = view.world->currentLevel;
+    m_seed = view.world->seed;
+    m_rng.setState(view.world->rngState, view.world->rngIncrement);
+    m_spawnCount = view.world->spawnCount;
+    m_repopulatePending = view.world->repopulatePending != 0;
+
+    for (size_t i = 0; i < m_aquariumlevels.size(); ++i) {
+        m_aquariumlevels[i]->setScore(view.levels[i].score);
+        for (int t = 0; t < kAquariumCreatureTypeCount; ++t) {
+            if (view.levels[i].population[t] >= 0) {
+                m_aquariumlevels[i]->setPopulation((AquariumCreatureType)t, view.levels[i].population[t]);
+            }
+        }
+    }
+
+    m_powerups.clear();
+    for (uint32_t i = 0; i < view.header->powerUpCount; ++i) {
+        const SnapshotPowerUp& pu = view.powerUps[i];
+        m_powerups.push_back(std::make_shared<PowerUp>(pu.x, pu.y, pu.radius, AQUARIUM_POWER_UP_SPRITE));
+    }
+
+    // a creature that already has the right class at its index stays where it is (handle,
+    // group and store slot included) and only gets its state overwritten; the rest become
+    // spares for the indices that need their class, their handles go stale
+    int count = (int)view.header->creatureCount;
+    int live = (int)m_creatures.size();
+    int common = std::min(count, live);
+    for (auto& spares : m_snapshotSpares) spares.clear();
+    m_snapshotRefill.clear();
+    bool arrays = m_storage == CreatureStorage::Arrays;
+    if (arrays) {
+        // the store has the types packed: runs that already match are skipped a block at a
+        // time, which is nearly all of them when rewinding a short way
+        const int block = 256;
+        for (int begin = 0; begin < common; begin += block) {
+            int end = std::min(begin + block, common);
+            if (std::memcmp(&m_store.type[begin], view.creatureTypes + begin, end - begin) == 0) continue;
+            for (int i = begin; i < end; ++i) {
+                if (m_store.type[i] == view.creatureTypes[i]) continue;
+                this->spareForSnapshot(i, m_store.type[i]);
+                m_snapshotRefill.push_back(i);
+            }
+        }
+        for (int i = common; i < live; ++i) this->spareForSnapshot(i, m_store.type[i]);
+    } else {
+        for (int i = 0; i < live; ++i) {
+            int type = (int)static_cast<NPCreature*>(m_creatures[i].get())->GetType();
+            if (i < count && type == view.creatureTypes[i]) continue;
+            this->spareForSnapshot(i, type);
+            if (i < count) m_snapshotRefill.push_back(i);
+        }
+    }
+    m_creatures.resize(count);
+    for (int i = live; i < count; ++i) m_snapshotRefill.push_back(i);
+    for (int t = 0; t < kAquariumCreatureTypeCount; ++t) m_groups.reserve(t, (int)view.header->typeCounts[t]);
+
+    // the columns go straight into the storage the creatures use: the store itself for
+    // array storage, scratch for objects which then copy their slot out
+    CreatureStore& columns = arrays ? m_store : m_snapshotStore;
+    columns.setBounds(m_width - 20, m_height - 20);
+    columns.unpack(view.creatures, count);
+
+    // only the indices that lost their creature above need one; with array storage that's
+    // all there is to do, the ones that stayed read their state from the store already
+    for (int i : m_snapshotRefill) {
+        AquariumCreatureType type = (AquariumCreatureType)view.creatureTypes[i];
+        auto& spares = m_snapshotSpares[(int)type];
+        if (!spares.empty()) {
+            m_creatures[i] = std::move(spares.back());
+            spares.pop_back();
+        } else {
+            // everything about it gets overwritten, only the class matters
+            m_creatures[i] = this->makeCreature(type, 0, 0, 0, RandomStream());
+        }
+        Creature* creature = m_creatures[i].get();
+        creature->setBounds(m_width - 20, m_height - 20);
+        creature->setAquariumIndex(i);
+        m_registry.add(creature);
+        m_groups.add((int)type, creature);
+        if (arrays) m_store.bind(i, creature);
+    }
+    if (!arrays) {
+        for (int i = 0; i < count; ++i) columns.copyOut(i, m_creatures[i].get());
+    }
+    for (auto& spares : m_snapshotSpares) spares.clear(); // what's left goes back to the pools
+
+    // the full rebuild on the next query fills these in
+    m_gridPoints.resize(count);
+    m_gridDirty = true;
+}
+
+// AquariumGameScene
+void AquariumGameScene::SaveSnapshot(std::vector<uint8_t>& out) const {
+    const Aquarium& aquarium = *this->m_aquarium;
+    int levelCount = aquarium.getLevelCount();
+    int powerUpCount = aquarium.getPowerUpCount();
+    int creatureCount = aquarium.getCreatureCount();
+    out.resize(SnapshotSize(levelCount, powerUpCount, creatureCount));
+
+    uint8_t* p = out.data();
+    SnapshotHeader* header = reinterpret_cast<SnapshotHeader*>(p);
+    header->magic = SNAPSHOT_MAGIC;
+    header->version = SNAPSHOT_VERSION;
+    header->levelCount = (uint16_t)levelCount;
+    header->creatureCount = (uint32_t)creatureCount;
+    header->powerUpCount = (uint32_t)powerUpCount;
+    header->width = aquarium.getWidth();
+    header->height = aquarium.getHeight();
+    for (int t = 0; t < kAquariumCreatureTypeCount; ++t) {
+        header->typeCounts[t] = (uint32_t)aquarium.getCreatureCount((AquariumCreatureType)t);
+    }
+    p += sizeof(SnapshotHeader);
+
+    SnapshotScene* scene = reinterpret_cast<SnapshotScene*>(p);
+    std::memset(scene, 0, sizeof(SnapshotScene));
+    scene->bigFishTicks = this->m_bigFishTicks;
+    scene->powerUpSpawned = this->m_powerUpSpawned;
+    p += sizeof(SnapshotScene);
+
+    this->m_player->saveSnapshot(*reinterpret_cast<SnapshotPlayer*>(p));
+    p += sizeof(SnapshotPlayer);
+
+    SnapshotWorld* world = reinterpret_cast<SnapshotWorld*>(p);
+    p += sizeof(SnapshotWorld);
+    SnapshotLevel* levels = reinterpret_cast<SnapshotLevel*>(p);
+    p += sizeof(SnapshotLevel) * levelCount;
+    SnapshotPowerUp* powerUps = reinterpret_cast<SnapshotPowerUp*>(p);
+    p += sizeof(SnapshotPowerUp) * powerUpCount;
+    aquarium.saveSnapshot(*world, levels, powerUps, p);
+}
+
+bool AquariumGameScene::RestoreSnapshot(const uint8_t* data, size_t size, std::string& error) {
+    SnapshotView view;
+    if (!view.parse(data, size, error)) return false;
+    Aquarium& aquarium = *this->m_aquarium;
+    if (view.header->levelCount != aquarium.getLevelCount()) {
+        error = "snapshot has " + std::to_string(view.header->levelCount) + " levels, the scene "
+              + std::to_string(aquarium.getLevelCount());
+        return false;
+    }
+    if (view.header->width != aquarium.getWidth() || view.header->height != aquarium.getHeight()) {
+        error = "snapshot is for a different aquarium size";
+        return false;
+    }
+
+    this->m_bigFishTicks = view.scene->bigFishTicks;
+    this->m_powerUpSpawned = view.scene->powerUpSpawned != 0;
+    this->m_player->loadSnapshot(*view.player);
+    aquarium.restoreSnapshot(view);
+    return true;
+}
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Binary snapshot of a running AquariumGameScene, written by AquariumGameScene::SaveSnapshot
+// and read back by RestoreSnapshot. Everything the simulation needs to carry on exactly
+// where it was is in there: player, scene counters, the aquarium's random stream and level
+// progress, power-ups and every creature including its own random stream and per-type state.
+// Handles and events are not: don't hold on to handles across a restore, they either go
+// stale or end up pointing at whichever creature took over that index.
+//
+//   SnapshotHeader
+//   SnapshotScene
+//   SnapshotPlayer
+//   SnapshotWorld
+//   SnapshotLevel   x levelCount
+//   SnapshotPowerUp x powerUpCount
+//   creature state  CreatureStore::PackedSize(creatureCount) bytes, one column after another
+//
+// Little-endian fixed size records, nothing to parse: a restore checks the sizes once and
+// then copies the creature columns straight into the aquarium's storage. The header carries
+// the per-type counts so a restore can size the groups and pools before touching a creature. A snapshot is only
+// meant for the same build and level set it came from, the version is bumped on any change.
+static const uint32_t SNAPSHOT_MAGIC = 0x53535141; // "AQSS"
+static const uint16_t SNAPSHOT_VERSION = 6;
+
+struct SnapshotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t levelCount;
+    uint32_t creatureCount;
+    uint32_t powerUpCount;
+    int32_t width;          // the aquarium's, creatures bounce off these walls
+    int32_t height;
+    uint32_t typeCounts[4]; // creatures of each AquariumCreatureType, they add up to creatureCount
+};
+
+struct SnapshotScene {
+    int32_t bigFishTicks;
+    uint8_t powerUpSpawned;
+    uint8_t reserved[3];
+};
+
+struct SnapshotPlayer {
+    float x, y, prevX, prevY, dx, dy;
+    float collisionRadius;
+    float visualScale;
+    int32_t speed;
+    int32_t score;
+    int32_t lives;
+    int32_t power;
+    int32_t damageDebounce;
+    uint8_t flipped;
+    uint8_t reserved[3];
+};
+
+struct SnapshotWorld {
+    uint64_t seed;
+    uint64_t rngState;
+    uint64_t rngIncrement;
+    uint64_t spawnCount;
+    int32_t currentLevel;
+    uint8_t repopulatePending;
+    uint8_t reserved[3];
+};
+
+struct SnapshotLevel {
+    int32_t score;
+    int32_t population[4]; // by AquariumCreatureType, -1 where the level has no such fish
+    uint32_t reserved;
+};
+
+struct SnapshotPowerUp {
+    float x, y, radius;
+    uint32_t reserved; // keeps the record a multiple of 8, see below
+};
+
+static_assert(sizeof(SnapshotHeader) == 40, "snapshot layout is part of the format");
+static_assert(sizeof(SnapshotScene) == 8, "snapshot layout is part of the format");
+static_assert(sizeof(SnapshotPlayer) == 56, "snapshot layout is part of the format");
+static_assert(sizeof(SnapshotWorld) == 40, "snapshot layout is part of the format");
+static_assert(sizeof(SnapshotLevel) == 24, "snapshot layout is part of the format");
+static_assert(sizeof(SnapshotPowerUp) == 16, "snapshot layout is part of the format");
+// every record ahead of the creature block is a multiple of 8 bytes, so its first (8 byte)
+// column starts 8 byte aligned whenever the snapshot itself does
+static_assert(sizeof(SnapshotHeader) % 8 == 0 && sizeof(SnapshotScene) % 8 == 0 && sizeof(SnapshotPlayer) % 8 == 0
+              && sizeof(SnapshotWorld) % 8 == 0 && sizeof(SnapshotLevel) % 8 == 0 && sizeof(SnapshotPowerUp) % 8 == 0,
+              "snapshot records keep the creature columns aligned");
+
+// read-only view over snapshot bytes, nothing is copied; valid while the bytes are
+struct SnapshotView {
+    const SnapshotHeader* header = nullptr;
+    const SnapshotScene* scene = nullptr;
+    const SnapshotPlayer* player = nullptr;
+    const SnapshotWorld* world = nullptr;
+    const SnapshotLevel* levels = nullptr;
+    const SnapshotPowerUp* powerUps = nullptr;
+    const uint8_t* creatures = nullptr;
+    const uint8_t* creatureTypes = nullptr; // the type column inside creatures
+
+    // checks magic, version and that every section fits, error says why on failure
+    bool parse(const uint8_t* data, size_t size, std::string& error);
+};
+
+// size of a snapshot with these counts
+size_t SnapshotSize(int levelCount, int powerUpCount, int creatureCount);
+
+// 64-bit checksum of a snapshot (or any bytes), a word at a time so hashing a whole
+// snapshot every tick stays cheap; only meant to tell states apart, not cryptographic
+uint64_t ChecksumBytes(const uint8_t* data, size_t size);
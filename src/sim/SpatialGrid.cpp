@@ -0,0 +1,62 @@
+#include "SpatialGrid.h"
+
+
+void SpatialGrid::configure(float width, float height, float cellSize) {
+    m_cellSize = std::max(cellSize, 1.0f);
+    m_invCellSize = 1.0f / m_cellSize;
+    m_cols = std::max(1, (int)std::ceil(width * m_invCellSize));
+    m_rows = std::max(1, (int)std::ceil(height * m_invCellSize));
+    m_cells.resize(m_cols * m_rows);
+    this->clear();
+}
+
+void SpatialGrid::clear() {
+    for (auto& cell : m_cells) cell.clear();
+    m_cellOf.clear();
+    m_slotOf.clear();
+}
+
+void SpatialGrid::build(const float* xs, const float* ys, int count, int stride) {
+    this->clear();
+    m_cellOf.reserve(count);
+    m_slotOf.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        this->insert(i, xs[(size_t)i * stride], ys[(size_t)i * stride]);
+    }
+}
+
+void SpatialGrid::insert(int id, float x, float y) {
+    int cell = this->cellAt(x, y);
+    m_cellOf.push_back(cell);
+    m_slotOf.push_back((int)m_cells[cell].size());
+    m_cells[cell].push_back(id);
+}
+
+void SpatialGrid::unlink(int id) {
+    std::vector<int>& cell = m_cells[m_cellOf[id]];
+    int slot = m_slotOf[id];
+    cell[slot] = cell.back();
+    m_slotOf[cell[slot]] = slot;
+    cell.pop_back();
+}
+
+void SpatialGrid::moveTo(int id, int cell) {
+    if (cell == m_cellOf[id]) return;
+    this->unlink(id);
+    m_cellOf[id] = cell;
+    m_slotOf[id] = (int)m_cells[cell].size();
+    m_cells[cell].push_back(id);
+}
+
+void SpatialGrid::removeSwapLast(int id) {
+    this->unlink(id);
+    int last = (int)m_cellOf.size() - 1;
+    if (id != last) {
+        // the last id keeps its cell and slot, only its number changes
+        m_cellOf[id] = m_cellOf[last];
+        m_slotOf[id] = m_slotOf[last];
+        m_cells[m_cellOf[id]][m_slotOf[id]] = id;
+    }
+    m_cellOf.pop_back();
+    m_slotOf.pop_back();
+}
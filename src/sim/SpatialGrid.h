@@ -0,0 +1,71 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+// Uniform grid over the aquarium used to narrow down collision candidates.
+// Entries are plain integer ids (the aquarium uses its creature index) so the
+// grid itself knows nothing about creatures. Every id remembers its cell and its
+// slot in it, so an id changing cell, going away or being renumbered is O(1) and
+// the grid only has to be built in full once; after that it follows the changes.
+class SpatialGrid {
+public:
+    SpatialGrid() = default;
+
+    // cellSize should be at least twice the largest collision radius so a
+    // radius query never has to look further than the neighbouring cells;
+    // drops every id, build or insert them again afterwards
+    void configure(float width, float height, float cellSize);
+    // ids 0..count-1 at the given positions, whatever was there before is dropped; stride is
+    // in floats, for positions that sit in an array of structs
+    void build(const float* xs, const float* ys, int count, int stride = 1);
+    void clear();
+
+    float getCellSize() const { return m_cellSize; }
+    int getCols() const { return m_cols; }
+    int getRows() const { return m_rows; }
+    int size() const { return (int)m_cellOf.size(); }
+
+    int cellAt(float x, float y) const { return cellCoord(y, m_rows) * m_cols + cellCoord(x, m_cols); }
+    int cellOf(int id) const { return m_cellOf[id]; }
+
+    // id has to be size(), ids stay dense
+    void insert(int id, float x, float y);
+    void moveTo(int id, int cell);
+    // the last id takes the removed one's place, the same way the aquarium fills its holes
+    void removeSwapLast(int id);
+
+    // calls fn(id) for every id stored in a cell overlapping the rectangle.
+    // ids come out cell by cell, callers still need their own exact test.
+    template <typename Fn>
+    void forEachInRect(float minX, float minY, float maxX, float maxY, Fn fn) const {
+        if (m_cellOf.empty()) return;
+        int c0 = cellCoord(minX, m_cols);
+        int c1 = cellCoord(maxX, m_cols);
+        int r0 = cellCoord(minY, m_rows);
+        int r1 = cellCoord(maxY, m_rows);
+        for (int r = r0; r <= r1; ++r) {
+            const std::vector<int>* row = m_cells.data() + r * m_cols;
+            for (int c = c0; c <= c1; ++c) {
+                for (int id : row[c]) fn(id);
+            }
+        }
+    }
+
+private:
+    int cellCoord(float v, int limit) const {
+        // truncating instead of flooring only differs below zero, which clamps to 0 either way
+        int c = (int)(v * m_invCellSize);
+        return std::clamp(c, 0, limit - 1); // creatures may overshoot the bounds before bouncing
+    }
+    void unlink(int id); // takes id out of its cell, leaves its bookkeeping alone
+
+    float m_cellSize = 1.0f;
+    float m_invCellSize = 1.0f;
+    int m_cols = 1;
+    int m_rows = 1;
+    std::vector<std::vector<int>> m_cells; // ids per cell, they keep their capacity when emptied
+    std::vector<int> m_cellOf;             // cell of each id
+    std::vector<int> m_slotOf;             // position of each id in its cell
+};
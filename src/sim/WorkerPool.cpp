@@ -0,0 +1,74 @@
+#include "WorkerPool.h"
+#include "Profiler.h"
+#include <algorithm>
+
+
+WorkerPool::WorkerPool(int threadCount) {
+    for (int i = 1; i < std::max(threadCount, 1); ++i) {
+        m_threads.emplace_back(&WorkerPool::workerLoop, this, i);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wake.notify_all();
+    for (auto& t : m_threads) t.join();
+}
+
+void WorkerPool::chunkRange(int chunk, int& begin, int& end) const {
+    begin = (int)((long long)m_count * chunk / m_chunks);
+    end = (int)((long long)m_count * (chunk + 1) / m_chunks);
+}
+
+void WorkerPool::parallelFor(int count, const std::function<void(int, int)>& fn, int minChunk) {
+    int chunks = std::min(this->getThreadCount(), count / std::max(minChunk, 1));
+    if (chunks <= 1) {
+        fn(0, count);
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_job = &fn;
+        m_count = count;
+        m_chunks = chunks;
+        m_pending = chunks - 1;
+        ++m_generation;
+    }
+    m_wake.notify_all();
+
+    // the caller takes chunk 0 instead of sitting idle
+    int begin, end;
+    this->chunkRange(0, begin, end);
+    fn(begin, end);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done.wait(lock, [this] { return m_pending == 0; });
+    m_job = nullptr;
+}
+
+void WorkerPool::workerLoop(int index) {
+    Profiler::SetThreadName("worker " + std::to_string(index));
+    unsigned long long seen = 0;
+    while (true) {
+        const std::function<void(int, int)>* job;
+        int begin = 0, end = 0;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&] { return m_stop || m_generation != seen; });
+            if (m_stop) return;
+            seen = m_generation;
+            if (index >= m_chunks) continue; // not needed for this job
+            job = m_job;
+            this->chunkRange(index, begin, end);
+        }
+        (*job)(begin, end);
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) m_done.notify_one();
+        }
+    }
+}
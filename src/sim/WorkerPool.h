@@ -0,0 +1,40 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed set of worker threads for data-parallel loops over creatures.
+// parallelFor splits [0, count) into one contiguous chunk per thread; the chunk
+// boundaries only depend on count and the thread count, so as long as each index
+// only touches its own data the result is the same as a plain loop.
+class WorkerPool {
+public:
+    explicit WorkerPool(int threadCount); // includes the calling thread
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    int getThreadCount() const { return (int)m_threads.size() + 1; }
+
+    // runs fn(begin, end) for every chunk and returns once all of them are done,
+    // small ranges below minChunk per thread just run on the caller
+    void parallelFor(int count, const std::function<void(int, int)>& fn, int minChunk = 1024);
+
+private:
+    void workerLoop(int index);
+    void chunkRange(int chunk, int& begin, int& end) const;
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::condition_variable m_done;
+    const std::function<void(int, int)>* m_job = nullptr;
+    int m_count = 0;
+    int m_chunks = 0;
+    int m_pending = 0;
+    unsigned long long m_generation = 0;
+    bool m_stop = false;
+};
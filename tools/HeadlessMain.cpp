@@ -0,0 +1,12 @@
+#include <cstdio>
+#include "HeadlessRunner.h"
+
+// Entry point of the standalone simulation build (headless.make): the same command line modes
+// as the game binary, linked against src/sim only, so no openFrameworks, GL or window system.
+int main(int argc, char* argv[]) {
+    int exitCode = 0;
+    if (RunCommandLineTool(argc, argv, exitCode)) return exitCode;
+    std::fprintf(stderr, "usage: aquarium-headless --headless [options] | --bench-micro [options] | --bench-grid | "
+                         "--bench-storage | --bench-kinematics | --bench-snapshot | --compile-levels in out\n");
+    return 2;
+}